@@ -0,0 +1,297 @@
+// Bitboard.cpp
+// This file contains the implementation of the bitboard attack functions
+
+// ------------------------- includes --------------------------
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include "Bitboard.h"
+#if PEXT_SUPPORTED
+#include <cpuid.h>
+#endif
+
+// --------------------- const definitions ---------------------
+
+// number of directions a bishop or a rook can move in
+constexpr int SLIDER_DIRECTIONS = 4;
+// (file, rank) steps of a bishop
+constexpr int BISHOP_STEPS[SLIDER_DIRECTIONS][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+// (file, rank) steps of a rook
+constexpr int ROOK_STEPS[SLIDER_DIRECTIONS][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+// number of entries in the rook attack table: the sum of 2^(relevant squares) over all squares
+constexpr int ROOK_TABLE_SIZE = 102400;
+// number of entries in the bishop attack table: the sum of 2^(relevant squares) over all squares
+constexpr int BISHOP_TABLE_SIZE = 5248;
+// max number of relevant occupancies of a slider on one square
+constexpr int MAX_OCCUPANCIES = 4096;
+// seeds of the magic number search, indexed by rank. chosen so that the search is short.
+constexpr uint64_t MAGIC_SEEDS[BOARD_SIZE] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+// min number of bits the magic number must map into the index's top byte
+constexpr int MIN_MAGIC_TOP_BITS = 6;
+// bitboard of the first rank
+constexpr Bitboard RANK_1_MASK = 0xFF;
+// bitboard of the first and eighth ranks
+constexpr Bitboard EDGE_RANKS_MASK = RANK_1_MASK | (RANK_1_MASK << (BOARD_SQUARES - BOARD_SIZE));
+// bitboard of the "A" and "H" files
+constexpr Bitboard EDGE_FILES_MASK = FILE_A_MASK | FILE_H_MASK;
+// environment variable overriding the slider attack backend: "magic" or "pext"
+constexpr auto SLIDER_BACKEND_VARIABLE = "CHESS_SLIDER_BACKEND";
+// CPUID vendor string of AMD processors, as returned in EBX, EDX, ECX
+constexpr char AMD_VENDOR[] = "AuthenticAMD";
+// CPUID family of AMD Zen 3. earlier AMD processors run PEXT in microcode, slower than a magic
+// lookup
+constexpr unsigned AMD_FAST_PEXT_FAMILY = 0x19;
+// offsets and masks of the base and extended family fields of CPUID leaf 1's EAX
+constexpr unsigned CPUID_FAMILY_SHIFT = 8, CPUID_FAMILY_MASK = 0xF,
+        CPUID_EXTENDED_FAMILY_SHIFT = 20, CPUID_EXTENDED_FAMILY_MASK = 0xFF;
+// names of the slider attack backends, indexed by SliderBackend
+constexpr const char* SLIDER_BACKEND_NAMES[] = {"magic", "pext"};
+
+// ------------------------ static data ------------------------
+
+// attack sets of the rooks, indexed through ROOK_MAGICS
+static Bitboard rookTable[ROOK_TABLE_SIZE];
+// attack sets of the bishops, indexed through BISHOP_MAGICS
+static Bitboard bishopTable[BISHOP_TABLE_SIZE];
+
+Magic ROOK_MAGICS[BOARD_SQUARES];
+Magic BISHOP_MAGICS[BOARD_SQUARES];
+SliderBackend sliderBackend = MAGIC_BACKEND;
+
+// ----------------- function implementation -------------------
+
+/**
+ * @brief returns the squares reached by sliding from the given square, up to and including the
+ * first occupied square in each direction.
+ * @param square - the sliding piece's square
+ * @param occupied - bitboard of all occupied squares on the board
+ * @param steps - (file, rank) steps of the piece
+ * @return bitboard of reached squares
+ */
+static Bitboard _sliderAttacks(Square square, Bitboard occupied,
+                               const int steps[SLIDER_DIRECTIONS][2])
+{
+    Bitboard attacks = EMPTY_BITBOARD;
+    for (int i = 0; i < SLIDER_DIRECTIONS; i++)
+    {
+        int file = fileOf(square) + steps[i][0];
+        int rank = rankOf(square) + steps[i][1];
+        while (isOnBoard(file, rank))
+        {
+            Bitboard mask = squareMask(makeSquare(file, rank));
+            attacks |= mask;
+            if (occupied & mask)
+            {
+                break;
+            }
+            file += steps[i][0];
+            rank += steps[i][1];
+        }
+    }
+    return attacks;
+}
+
+/**
+ * @brief returns the next number of a xorshift64* pseudo-random sequence
+ * @param state - non-const ref to the state of the sequence, which is advanced
+ * @return the next pseudo-random number
+ */
+static uint64_t _nextRandom(uint64_t& state)
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ULL;
+}
+
+/**
+ * @brief fills the attack table of a slider on every square for the given backend. for the magic
+ * backend, finds a magic number per square mapping every relevant occupancy to its attack set
+ * without harmful collisions.
+ * @param magics - the slider's magic entries, indexed by Square, which the function fills
+ * @param table - the slider's attack table, which the function fills
+ * @param steps - (file, rank) steps of the slider
+ * @param backend - the backend whose indices the table is filled for
+ */
+static void _initSliderTable(Magic magics[], Bitboard table[],
+                             const int steps[SLIDER_DIRECTIONS][2], SliderBackend backend)
+{
+    static Bitboard occupancies[MAX_OCCUPANCIES], references[MAX_OCCUPANCIES];
+    static int epochs[MAX_OCCUPANCIES];
+    // stamps left by a previous build would make fresh slots look written
+    std::fill(epochs, epochs + MAX_OCCUPANCIES, 0);
+    int epoch = 0, offset = 0;
+    for (int square = 0; square < BOARD_SQUARES; square++)
+    {
+        auto sq = Square(square);
+        Bitboard edges = (EDGE_RANKS_MASK & ~(RANK_1_MASK << (BOARD_SIZE * rankOf(sq)))) |
+                         (EDGE_FILES_MASK & ~(FILE_A_MASK << fileOf(sq)));
+        Magic& magic = magics[square];
+        magic.mask = _sliderAttacks(sq, EMPTY_BITBOARD, steps) & ~edges;
+        magic.shift = BOARD_SQUARES - popCount(magic.mask);
+        magic.attacks = table + offset;
+
+        // enumerate all subsets of the mask (Carry-Rippler), in the order of their PEXT indices
+        int size = 0;
+        Bitboard occupied = EMPTY_BITBOARD;
+        do
+        {
+            occupancies[size] = occupied;
+            references[size] = _sliderAttacks(sq, occupied, steps);
+            size++;
+            occupied = (occupied - magic.mask) & magic.mask;
+        } while (occupied);
+        offset += size;
+
+        if (backend == PEXT_BACKEND)
+        {
+            magic.magic = 0;
+            std::copy(references, references + size, magic.attacks);
+            continue;
+        }
+        uint64_t state = MAGIC_SEEDS[rankOf(sq)];
+        for (int i = 0; i < size; )
+        {
+            do
+            {
+                magic.magic = _nextRandom(state) & _nextRandom(state) & _nextRandom(state);
+            } while (popCount((magic.mask * magic.magic) >> (BOARD_SQUARES - BOARD_SIZE)) <
+                     MIN_MAGIC_TOP_BITS);
+
+            epoch++;
+            for (i = 0; i < size; i++)
+            {
+                unsigned index = magic.magicIndex(occupancies[i]);
+                if (epochs[index] < epoch)
+                {
+                    epochs[index] = epoch;
+                    magic.attacks[index] = references[i];
+                }
+                else if (magic.attacks[index] != references[i])
+                {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief checks whether the CPU executes PEXT, i.e. supports BMI2
+ * @return true if the PEXT backend can be used; false otherwise
+ */
+bool isPextSupported()
+{
+#if PEXT_SUPPORTED
+    __builtin_cpu_init(); // may run in a static initializer, before the CPU model is read
+    return __builtin_cpu_supports("bmi2");
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief checks whether the CPU executes PEXT in hardware, i.e. supports BMI2 and isn't an AMD
+ * processor older than Zen 3
+ * @return true if the PEXT backend is expected to beat the magic backend; false otherwise
+ */
+bool isPextFast()
+{
+#if PEXT_SUPPORTED
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!isPextSupported() || !__get_cpuid(0, &eax, &ebx, &ecx, &edx))
+    {
+        return false;
+    }
+    char vendor[sizeof(AMD_VENDOR)] = {};
+    std::memcpy(vendor, &ebx, sizeof(ebx));
+    std::memcpy(vendor + sizeof(ebx), &edx, sizeof(edx));
+    std::memcpy(vendor + sizeof(ebx) + sizeof(edx), &ecx, sizeof(ecx));
+    if (std::strcmp(vendor, AMD_VENDOR) != 0)
+    {
+        return true;
+    }
+    __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+    unsigned family = (eax >> CPUID_FAMILY_SHIFT) & CPUID_FAMILY_MASK;
+    if (family == CPUID_FAMILY_MASK)
+    {
+        family += (eax >> CPUID_EXTENDED_FAMILY_SHIFT) & CPUID_EXTENDED_FAMILY_MASK;
+    }
+    return family >= AMD_FAST_PEXT_FAMILY;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief selects the slider attack backend and rebuilds the attack tables for it. must not be
+ * called while other threads query attacks.
+ * @param backend - MAGIC_BACKEND, or PEXT_BACKEND
+ * @return true if the backend has been selected; false if it's PEXT_BACKEND and the CPU doesn't
+ * support it
+ */
+bool setSliderBackend(SliderBackend backend)
+{
+    if ((backend == PEXT_BACKEND) && !isPextSupported())
+    {
+        return false;
+    }
+    sliderBackend = backend;
+    _initSliderTable(ROOK_MAGICS, rookTable, ROOK_STEPS, backend);
+    _initSliderTable(BISHOP_MAGICS, bishopTable, BISHOP_STEPS, backend);
+    return true;
+}
+
+/**
+ * @brief selects the slider attack backend by name, and rebuilds the attack tables for it
+ * @param name - "magic" or "pext"
+ * @return true if the backend has been selected; false if name is unknown, or is "pext" and the
+ * CPU doesn't support it
+ */
+bool setSliderBackend(const char* name)
+{
+    for (int backend = MAGIC_BACKEND; backend <= PEXT_BACKEND; backend++)
+    {
+        if (std::strcmp(name, SLIDER_BACKEND_NAMES[backend]) == 0)
+        {
+            return setSliderBackend(SliderBackend(backend));
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief returns the name of the selected slider attack backend
+ * @return "magic" or "pext"
+ */
+const char* sliderBackendName()
+{
+    return SLIDER_BACKEND_NAMES[sliderBackend];
+}
+
+/**
+ * This struct initializes the slider attack tables before main runs: with the PEXT backend if the
+ * CPU runs it in hardware, unless the environment variable CHESS_SLIDER_BACKEND names another
+ * backend.
+ */
+static struct SliderTablesInitializer
+{
+    SliderTablesInitializer()
+    {
+        const char* name = std::getenv(SLIDER_BACKEND_VARIABLE);
+        if ((name == nullptr) || !setSliderBackend(name))
+        {
+            setSliderBackend(isPextFast() ? PEXT_BACKEND: MAGIC_BACKEND);
+        }
+    }
+} sliderTablesInitializer;
+
+/**
+ * @brief returns the memory taken by the slider attack tables
+ * @return size of the rook and bishop tables and magic entries, in bytes
+ */
+size_t sliderTablesSize()
+{
+    return sizeof(rookTable) + sizeof(bishopTable) + sizeof(ROOK_MAGICS) + sizeof(BISHOP_MAGICS);
+}
\ No newline at end of file
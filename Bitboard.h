@@ -0,0 +1,413 @@
+// Bitboard.h
+
+#ifndef CHESS_CPP_BITBOARD_H
+#define CHESS_CPP_BITBOARD_H
+
+// ------------------------- includes --------------------------
+
+#include <array>
+#include <cstdint>
+#include "Piece.h"
+
+// --------------------- const definitions ---------------------
+
+// bitboard with no squares
+constexpr Bitboard EMPTY_BITBOARD = 0;
+// bitboard of the "A" file
+constexpr Bitboard FILE_A_MASK = 0x0101010101010101ULL;
+// bitboard of the "H" file
+constexpr Bitboard FILE_H_MASK = FILE_A_MASK << (BOARD_SIZE - 1);
+// number of squares a knight or a king can jump to
+constexpr int LEAPER_STEPS_NUM = 8;
+// (file, rank) steps of a knight
+constexpr int KNIGHT_STEPS[LEAPER_STEPS_NUM][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2},
+                                                   {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+// (file, rank) steps of a king
+constexpr int KING_STEPS[LEAPER_STEPS_NUM][2] = {{1, 1}, {1, 0}, {1, -1}, {0, -1},
+                                                 {-1, -1}, {-1, 0}, {-1, 1}, {0, 1}};
+// rank of the white pawns' initial squares
+constexpr int WHITE_PAWN_RANK = 1;
+// rank of the black pawns' initial squares
+constexpr int BLACK_PAWN_RANK = BOARD_SIZE - 2;
+
+/**
+ * a table holding a bitboard per square
+ */
+typedef std::array<Bitboard, BOARD_SQUARES> SquareTable;
+
+// whether the PEXT instruction can be emitted, i.e. the target is x86-64 and the compiler takes
+// GNU inline assembly. whether the CPU runs it is checked at runtime.
+#if defined(__x86_64__) && defined(__GNUC__)
+#define PEXT_SUPPORTED 1
+#else
+#define PEXT_SUPPORTED 0
+#endif
+
+/**
+ * the ways to index the slider attack tables
+ */
+enum SliderBackend
+{
+    MAGIC_BACKEND, /** multiply by a magic number and shift: portable */
+    PEXT_BACKEND /** extract the relevant occupancy bits with BMI2 PEXT */
+};
+
+// --------------------- struct declaration --------------------
+
+/**
+ * the magic bitboard entry of a slider on one square: multiplying the relevant occupancy by the
+ * magic number and shifting gathers it into a unique index of the square's attack table.
+ */
+struct Magic
+{
+    Bitboard mask; /** relevant occupancy: the slider's rays, without the board's edges */
+    Bitboard magic; /** the magic number */
+    Bitboard* attacks; /** the square's attack table, indexed by index() */
+    int shift; /** 64 minus the number of squares in mask */
+
+    /**
+     * @brief returns the index of the attack set for the given occupancy with the magic backend
+     * @param occupied - bitboard of all occupied squares on the board
+     * @return index into attacks
+     */
+    unsigned magicIndex(Bitboard occupied) const
+    {
+        return unsigned(((occupied & mask) * magic) >> shift);
+    }
+
+    /**
+     * @brief returns the index of the attack set for the given occupancy with the selected backend
+     * @param occupied - bitboard of all occupied squares on the board
+     * @return index into attacks
+     */
+    unsigned index(Bitboard occupied) const;
+};
+
+// magic entries of the rooks, indexed by Square. filled before main runs.
+extern Magic ROOK_MAGICS[BOARD_SQUARES];
+// magic entries of the bishops, indexed by Square. filled before main runs.
+extern Magic BISHOP_MAGICS[BOARD_SQUARES];
+// the selected slider attack backend
+extern SliderBackend sliderBackend;
+
+/**
+ * @brief gathers the bits of value selected by mask into the low bits of the result, like the
+ * BMI2 PEXT instruction. assumes: PEXT_SUPPORTED and the CPU supports BMI2.
+ * @param value - a bitboard
+ * @param mask - the bits to gather
+ * @return the gathered bits
+ */
+inline Bitboard pext(Bitboard value, Bitboard mask)
+{
+#if PEXT_SUPPORTED
+    Bitboard result;
+    asm("pextq %2, %1, %0": "=r"(result): "r"(value), "r"(mask));
+    return result;
+#else
+    return value & mask;
+#endif
+}
+
+inline unsigned Magic::index(Bitboard occupied) const
+{
+    if (PEXT_SUPPORTED && (sliderBackend == PEXT_BACKEND))
+    {
+        return unsigned(pext(occupied, mask));
+    }
+    return magicIndex(occupied);
+}
+
+// ------------------- function declarations -------------------
+
+/**
+ * @brief returns a bitboard containing only the given square
+ * @param square - a square on the board
+ * @return the bitboard of the square
+ */
+constexpr Bitboard squareMask(Square square) {return Bitboard(1) << square; }
+
+/**
+ * @brief counts the squares in a bitboard
+ * @param bitboard - a set of squares
+ * @return number of squares in bitboard
+ */
+inline int popCount(Bitboard bitboard) {return __builtin_popcountll(bitboard); }
+
+/**
+ * @brief returns the lowest square in a bitboard. assumes: bitboard is not empty.
+ * @param bitboard - a set of squares
+ * @return the lowest square in bitboard
+ */
+inline Square lsb(Bitboard bitboard) {return Square(__builtin_ctzll(bitboard)); }
+
+/**
+ * @brief removes the lowest square from a bitboard and returns it. assumes: bitboard is not empty.
+ * @param bitboard - non-const ref to a set of squares, from which the lowest square is removed.
+ * @return the removed square
+ */
+inline Square popLsb(Bitboard& bitboard)
+{
+    Square square = lsb(bitboard);
+    bitboard &= bitboard - 1;
+    return square;
+}
+
+/**
+ * @brief generates the table of the squares reached by single steps from every square
+ * @param steps - (file, rank) steps of the leaping piece
+ * @return table of reached squares, indexed by Square
+ */
+constexpr SquareTable _createLeaperTable(const int steps[LEAPER_STEPS_NUM][2])
+{
+    SquareTable table = {};
+    for (int square = 0; square < BOARD_SQUARES; square++)
+    {
+        int file = fileOf(Square(square)), rank = rankOf(Square(square));
+        for (int i = 0; i < LEAPER_STEPS_NUM; i++)
+        {
+            int destFile = file + steps[i][0], destRank = rank + steps[i][1];
+            if (isOnBoard(destFile, destRank))
+            {
+                table[square] |= squareMask(makeSquare(destFile, destRank));
+            }
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief generates the table of the squares a pawn attacks from every square
+ * @param color - color of the pawn: WHITE or BLACK
+ * @return table of attacked squares, indexed by Square
+ */
+constexpr SquareTable _createPawnAttackTable(int color)
+{
+    SquareTable table = {};
+    for (int square = 0; square < BOARD_SQUARES; square++)
+    {
+        Bitboard pawn = squareMask(Square(square));
+        if (color == WHITE)
+        {
+            table[square] = ((pawn & ~FILE_A_MASK) << (BOARD_SIZE - 1)) |
+                             ((pawn & ~FILE_H_MASK) << (BOARD_SIZE + 1));
+        }
+        else
+        {
+            table[square] = ((pawn & ~FILE_H_MASK) >> (BOARD_SIZE - 1)) |
+                            ((pawn & ~FILE_A_MASK) >> (BOARD_SIZE + 1));
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief generates the table of the squares a pawn moves to without capturing from every square,
+ * i.e. one square forward, or two from its initial rank.
+ * @param color - color of the pawn: WHITE or BLACK
+ * @return table of reached squares, indexed by Square
+ */
+constexpr SquareTable _createPawnPushTable(int color)
+{
+    SquareTable table = {};
+    int initialRank = (color == WHITE ? WHITE_PAWN_RANK: BLACK_PAWN_RANK);
+    for (int square = 0; square < BOARD_SQUARES; square++)
+    {
+        int file = fileOf(Square(square)), rank = rankOf(Square(square));
+        if (isOnBoard(file, rank + color))
+        {
+            table[square] |= squareMask(makeSquare(file, rank + color));
+        }
+        if (rank == initialRank)
+        {
+            table[square] |= squareMask(makeSquare(file, rank + 2 * color));
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief generates the table of the squares strictly between every two squares sharing a rank,
+ * file or diagonal
+ * @return table of squares between from and to, indexed by from and to
+ */
+constexpr std::array<SquareTable, BOARD_SQUARES> _createBetweenTable()
+{
+    std::array<SquareTable, BOARD_SQUARES> table = {};
+    for (int from = 0; from < BOARD_SQUARES; from++)
+    {
+        for (int to = 0; to < BOARD_SQUARES; to++)
+        {
+            int fileDiff = fileOf(Square(to)) - fileOf(Square(from));
+            int rankDiff = rankOf(Square(to)) - rankOf(Square(from));
+            if ((fileDiff != 0) && (rankDiff != 0) && (fileDiff != rankDiff) &&
+                (fileDiff != -rankDiff))
+            {
+                continue;
+            }
+            int fileDirection = (fileDiff > 0) - (fileDiff < 0); //sgn function
+            int rankDirection = (rankDiff > 0) - (rankDiff < 0);
+            int step = fileDirection + BOARD_SIZE * rankDirection;
+            for (int square = from + step; (from != to) && (square != to); square += step)
+            {
+                table[from][to] |= squareMask(Square(square));
+            }
+        }
+    }
+    return table;
+}
+
+// squares a knight attacks, indexed by Square
+inline constexpr SquareTable KNIGHT_ATTACKS = _createLeaperTable(KNIGHT_STEPS);
+// squares a king attacks, indexed by Square
+inline constexpr SquareTable KING_ATTACKS = _createLeaperTable(KING_STEPS);
+// squares a pawn attacks, indexed by colorIndex() and Square
+inline constexpr SquareTable PAWN_ATTACKS[COLOR_NUM] = {_createPawnAttackTable(WHITE),
+                                                        _createPawnAttackTable(BLACK)};
+// squares a pawn moves to without capturing, indexed by colorIndex() and Square
+inline constexpr SquareTable PAWN_PUSHES[COLOR_NUM] = {_createPawnPushTable(WHITE),
+                                                       _createPawnPushTable(BLACK)};
+// squares strictly between two aligned squares, indexed by Square and Square
+inline constexpr std::array<SquareTable, BOARD_SQUARES> BETWEEN = _createBetweenTable();
+
+/**
+ * @brief returns the squares a pawn attacks, i.e. the squares diagonally in front of it.
+ * @param color - color of the pawn: WHITE or BLACK
+ * @param square - the pawn's square
+ * @return bitboard of attacked squares
+ */
+constexpr Bitboard pawnAttacks(int color, Square square)
+{
+    return PAWN_ATTACKS[colorIndex(color)][square];
+}
+
+/**
+ * @brief returns the squares a pawn moves to without capturing on an empty board, i.e. one square
+ * forward, or two from its initial rank.
+ * @param color - color of the pawn: WHITE or BLACK
+ * @param square - the pawn's square
+ * @return bitboard of reached squares
+ */
+constexpr Bitboard pawnPushes(int color, Square square)
+{
+    return PAWN_PUSHES[colorIndex(color)][square];
+}
+
+/**
+ * @brief returns the squares a knight on the given square attacks
+ * @param square - the knight's square
+ * @return bitboard of attacked squares
+ */
+constexpr Bitboard knightAttacks(Square square) {return KNIGHT_ATTACKS[square]; }
+
+/**
+ * @brief returns the squares a king on the given square attacks
+ * @param square - the king's square
+ * @return bitboard of attacked squares
+ */
+constexpr Bitboard kingAttacks(Square square) {return KING_ATTACKS[square]; }
+
+/**
+ * @brief returns the squares a bishop on the given square attacks, i.e. every square along its
+ * diagonals up to and including the first occupied square.
+ * @param square - the bishop's square
+ * @param occupied - bitboard of all occupied squares on the board
+ * @return bitboard of attacked squares
+ */
+inline Bitboard bishopAttacks(Square square, Bitboard occupied)
+{
+    const Magic& magic = BISHOP_MAGICS[square];
+    return magic.attacks[magic.index(occupied)];
+}
+
+/**
+ * @brief returns the squares a rook on the given square attacks, i.e. every square along its
+ * rank and file up to and including the first occupied square.
+ * @param square - the rook's square
+ * @param occupied - bitboard of all occupied squares on the board
+ * @return bitboard of attacked squares
+ */
+inline Bitboard rookAttacks(Square square, Bitboard occupied)
+{
+    const Magic& magic = ROOK_MAGICS[square];
+    return magic.attacks[magic.index(occupied)];
+}
+
+/**
+ * @brief returns the squares attacked by a piece of the given type.
+ * @param type - type of the piece
+ * @param color - color of the piece: WHITE or BLACK
+ * @param square - the piece's square
+ * @param occupied - bitboard of all occupied squares on the board
+ * @return bitboard of attacked squares
+ */
+inline Bitboard pieceAttacks(PieceType type, int color, Square square, Bitboard occupied)
+{
+    switch (type)
+    {
+        case PAWN:
+            return pawnAttacks(color, square);
+        case KNIGHT:
+            return knightAttacks(square);
+        case BISHOP:
+            return bishopAttacks(square, occupied);
+        case ROOK:
+            return rookAttacks(square, occupied);
+        case QUEEN:
+            return bishopAttacks(square, occupied) | rookAttacks(square, occupied);
+        default:
+            return kingAttacks(square);
+    }
+}
+
+/**
+ * @brief returns the memory taken by the slider attack tables
+ * @return size of the rook and bishop tables and magic entries, in bytes
+ */
+size_t sliderTablesSize();
+
+/**
+ * @brief checks whether the CPU executes PEXT, i.e. supports BMI2
+ * @return true if the PEXT backend can be used; false otherwise
+ */
+bool isPextSupported();
+
+/**
+ * @brief checks whether the CPU executes PEXT in hardware, i.e. supports BMI2 and isn't an AMD
+ * processor older than Zen 3, which runs it in microcode
+ * @return true if the PEXT backend is expected to beat the magic backend; false otherwise
+ */
+bool isPextFast();
+
+/**
+ * @brief selects the slider attack backend and rebuilds the attack tables for it. must not be
+ * called while other threads query attacks.
+ * @param backend - MAGIC_BACKEND, or PEXT_BACKEND
+ * @return true if the backend has been selected; false if it's PEXT_BACKEND and the CPU doesn't
+ * support it
+ */
+bool setSliderBackend(SliderBackend backend);
+
+/**
+ * @brief selects the slider attack backend by name, and rebuilds the attack tables for it
+ * @param name - "magic" or "pext"
+ * @return true if the backend has been selected; false if name is unknown, or is "pext" and the
+ * CPU doesn't support it
+ */
+bool setSliderBackend(const char* name);
+
+/**
+ * @brief returns the name of the selected slider attack backend
+ * @return "magic" or "pext"
+ */
+const char* sliderBackendName();
+
+/**
+ * @brief returns the squares strictly between two squares sharing a rank, file or diagonal.
+ * @param from - a square on the board
+ * @param to - a square on the board
+ * @return bitboard of squares between from and to, excluding both; empty if from and to are not
+ * aligned or are adjacent.
+ */
+constexpr Bitboard betweenMask(Square from, Square to) {return BETWEEN[from][to]; }
+
+#endif //CHESS_CPP_BITBOARD_H
\ No newline at end of file
@@ -3,6 +3,10 @@
 
 // ------------------------- includes --------------------------
 
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <sstream>
 #include "Board.h"
 
 // --------------------- const definitions ---------------------
@@ -26,135 +30,203 @@ constexpr int SQUARE_COLOR_NUM = 2;
 // _print space
 constexpr auto SPACE = " ";
 
-// ------------------- class implementation --------------------
+// types of the pieces initially placed on the back rank, from the "A" file to the "H" file
+constexpr PieceType BACK_RANK[BOARD_SIZE] = {ROOK, KNIGHT, BISHOP, QUEEN, KING, BISHOP, KNIGHT,
+                                             ROOK};
+// first square of black's back rank
+constexpr Square BLACK_BACK_RANK = A8;
+// file of the kings' initial squares
+constexpr int KING_FILE = 4;
+// max number of pieces of one color
+constexpr int MAX_PIECES = 2 * BOARD_SIZE;
+// separator of ranks in a FEN piece placement
+constexpr char FEN_RANK_SEPARATOR = '/';
+// FEN field of an empty castling availability or en passant square
+constexpr auto FEN_NONE = "-";
+// FEN side to move: white
+constexpr auto FEN_WHITE = "w";
+// FEN side to move: black
+constexpr auto FEN_BLACK = "b";
+// FEN castling letters, in the order of the castling right bits: WHITE_KINGSIDE first
+constexpr char FEN_CASTLING[] = {'K', 'Q', 'k', 'q'};
+// number of castling rights
+constexpr int CASTLING_RIGHTS_NUM = 4;
+// rank of the en passant square when white is to move
+constexpr int WHITE_EN_PASSANT_RANK = BOARD_SIZE - 3;
+// rank of the en passant square when black is to move
+constexpr int BLACK_EN_PASSANT_RANK = 2;
+// returned by _parseCastlingRights for an invalid castling field
+constexpr int INVALID_CASTLING = -1;
 
 /**
- * @brief returns the piece that's in square <position> in the matrix
- * @param position - a square in the matrix, e.g. "A1", representing the position from which a piece
- * is retrieved.
- * @return the retrieved piece; nullptr if the given square in the matrix is empty.
+ * @brief generates the castling masks: for every square, the castling rights that survive a move
+ * from or to that square.
+ * @return table of castling masks, indexed by Square
  */
-Piece* Board::_getPiece(const string &position) const
+constexpr std::array<int, BOARD_SQUARES> _createCastlingMasks()
 {
-    return _board[position[FILE_INDEX] - MIN_FILE][position[RANK_INDEX] - MIN_RANK];
+    std::array<int, BOARD_SQUARES> masks = {};
+    for (int square = 0; square < BOARD_SQUARES; square++)
+    {
+        masks[square] = ALL_CASTLING;
+    }
+    masks[E1] &= ~(WHITE_KINGSIDE | WHITE_QUEENSIDE);
+    masks[A1] &= ~WHITE_QUEENSIDE;
+    masks[H1] &= ~WHITE_KINGSIDE;
+    masks[E8] &= ~(BLACK_KINGSIDE | BLACK_QUEENSIDE);
+    masks[A8] &= ~BLACK_QUEENSIDE;
+    masks[H8] &= ~BLACK_KINGSIDE;
+    return masks;
 }
 
+// castling rights that survive a move from or to a square, indexed by Square
+constexpr std::array<int, BOARD_SQUARES> CASTLING_MASKS = _createCastlingMasks();
+
+// ------------------- class implementation --------------------
+
 /**
- * @brief places a piece in the given position in the matrix
- * @param piece - the piece to be placed
- * @param position - a square in the matrix, e.g. "A1", representing the piece's new position.
+ * @brief places a piece in the given square of the mailbox and updates the occupancy masks, the
+ * hash keys and the piece-square scores.
+ * whatever piece was in the square before is only unlinked from the board, not freed.
+ * @param piece - the piece to be placed; nullptr to empty the square
+ * @param square - a square on the board
  */
-void Board::_setPiece(Piece *piece, const string &position)
+void Board::_setPiece(Piece *piece, Square square)
 {
-    _board[position[FILE_INDEX] - MIN_FILE][position[RANK_INDEX] - MIN_RANK] = piece;
+    Bitboard mask = squareMask(square);
+    Piece* oldPiece = _board[square];
+    if (oldPiece != nullptr)
+    {
+        int oldColor = colorIndex(oldPiece->getColor());
+        _pieceMasks[oldColor][oldPiece->getType()] &= ~mask;
+        _colorMasks[oldColor] &= ~mask;
+        _key ^= pieceKey(oldPiece->getColor(), oldPiece->getType(), square);
+        _phaseScores[MIDGAME] -= pieceSquareScore(MIDGAME, oldPiece->getColor(),
+                                                  oldPiece->getType(), square);
+        _phaseScores[ENDGAME] -= pieceSquareScore(ENDGAME, oldPiece->getColor(),
+                                                  oldPiece->getType(), square);
+        _phase -= PHASE_WEIGHTS[oldPiece->getType()];
+        if (oldPiece->isPawn())
+        {
+            _pawnKey ^= pieceKey(oldPiece->getColor(), PAWN, square);
+        }
+    }
+    _board[square] = piece;
+    if (piece != nullptr)
+    {
+        int color = colorIndex(piece->getColor());
+        _pieceMasks[color][piece->getType()] |= mask;
+        _colorMasks[color] |= mask;
+        _key ^= pieceKey(piece->getColor(), piece->getType(), square);
+        _phaseScores[MIDGAME] += pieceSquareScore(MIDGAME, piece->getColor(), piece->getType(),
+                                                  square);
+        _phaseScores[ENDGAME] += pieceSquareScore(ENDGAME, piece->getColor(), piece->getType(),
+                                                  square);
+        _phase += PHASE_WEIGHTS[piece->getType()];
+        if (piece->isPawn())
+        {
+            _pawnKey ^= pieceKey(piece->getColor(), PAWN, square);
+        }
+    }
 }
 
 /**
- * @brief places a piece in the given position in the matrix, and updates that piece's position.
+ * @brief places a piece in the given square on the board, and updates that piece's position.
  * @param piece - the piece to be moved. assumes: piece isn't nullptr.
- * @param position - a square in the matrix, e.g. "A1", representing the piece's new position.
+ * @param square - a square on the board, representing the piece's new position.
  */
-void Board::_movePiece(Piece *piece, const string &position)
+void Board::_movePiece(Piece *piece, Square square)
 {
-    _setPiece(piece, position);
-    piece->setPosition(position);
+    _setPiece(piece, square);
+    piece->setPosition(square);
 }
 
 /**
- * @brief remove the piece placed in the given position from the matrix and from its respective set.
- * frees memory in freestore.
- * @param position - a square in the matrix, e.g. "A1", representing the position from which a piece
- * is to be removed.
+ * @brief generates all pieces in the white / black set with their initial positions and places
+ * them on the board. allocates memory in the pool.
+ * @param color - color of set: WHITE or BLACK
  */
-void Board::_removePiece(const string &position)
+void Board::_createPieces(int color)
 {
-    Piece* piece = _getPiece(position);
-    if (piece != nullptr)
+    int backRank = rankOf(color == WHITE ? A1: BLACK_BACK_RANK);
+    int pawnRank = backRank + color;
+    for (int file = 0; file < BOARD_SIZE; file++)
     {
-        vector<Piece*>& pieces = _getPieces(piece->getColor());
-        pieces.erase(std::remove(pieces.begin(), pieces.end(), piece), pieces.end());
-        delete piece;
-        _setPiece(nullptr, position);
+        Square square = makeSquare(file, backRank);
+        _setPiece(_createPiece(BACK_RANK[file], color, square), square);
+        square = makeSquare(file, pawnRank);
+        _setPiece(_createPiece(PAWN, color, square), square);
     }
 }
 
 /**
- * @brief returns the set of pieces in the given color
- * @param color - color of set: WHITE or BLACK
- * @return the set of pieces in the given color.
+ * @brief generates a piece of the given type. allocates memory in the pool.
+ * @param type - type of the piece, e.g. ROOK
+ * @param color - color of the piece: WHITE or BLACK
+ * @param position - initial position of the piece on the board, e.g. A1
+ * @return the new piece
  */
-vector<Piece*>& Board::_getPieces(int color)
+Piece* Board::_createPiece(PieceType type, int color, Square position)
 {
-    return (color == WHITE ? _whitePieces: _blackPieces);
+    switch (type)
+    {
+        case PAWN:
+            return new (_pool.allocate()) Pawn(color, position);
+        case KNIGHT:
+            return new (_pool.allocate()) Knight(color, position);
+        case BISHOP:
+            return new (_pool.allocate()) Bishop(color, position);
+        case ROOK:
+            return new (_pool.allocate()) Rook(color, position);
+        case QUEEN:
+            return new (_pool.allocate()) Queen(color, position);
+        default:
+            return new (_pool.allocate()) King(color, position);
+    }
 }
 
 /**
- * @brief returns the king in the given color
- * @param color - color of king: WHITE or BLACK
- * @return the king in the given color
+ * @brief deep-copies all pieces of another Board onto this (empty) Board.
+ * @param other - other Board, whose pieces are copied
  */
-Piece* Board::_getKing(int color) const
+void Board::_copyPieces(const Board& other)
 {
-    return (color == WHITE ? _whiteKing: _blackKing);
-}
-
-/**
- * @brief generates all pieces in the white / black set with their initial positions. allocates
- * memory in freestore.
- * @param color - color of set: WHITE or BLACK
- */
-void Board::_createPieces(int color)
-{
-    vector<Piece*>& pieces = _getPieces(color);
-    char rankPosition = (color == WHITE ? MIN_RANK: MAX_RANK), filePosition = MIN_FILE;
-    string rankString = string(1, rankPosition), fileString;
-
-    pieces.push_back((Piece *) (new Rook(color, string(1, filePosition++) + rankString)));
-    pieces.push_back((Piece *) (new Knight(color, string(1, filePosition++) + rankString)));
-    pieces.push_back((Piece *) (new Bishop(color, string(1, filePosition++) + rankString)));
-    pieces.push_back((Piece *) (new Queen(color, string(1, filePosition++) + rankString)));
-    pieces.push_back((Piece *) (new King(color, string(1, filePosition++) + rankString)));
-    pieces.push_back((Piece *) (new Bishop(color, string(1, filePosition++) + rankString)));
-    pieces.push_back((Piece *) (new Knight(color, string(1, filePosition++) + rankString)));
-    pieces.push_back((Piece *) (new Rook(color, string(1, filePosition) + rankString)));
-
-    rankString = string(1, rankPosition + color);
-    for (filePosition = MIN_FILE; filePosition <= MAX_FILE; filePosition++)
+    Bitboard occupied = other.getOccupancy();
+    while (occupied)
     {
-        fileString = string(1, filePosition);
-        pieces.push_back((Piece *) (new Pawn(color, fileString + rankString)));
+        Square square = popLsb(occupied);
+        _setPiece(other._board[square]->clone(_pool.allocate()), square);
     }
+    _castlingRights = other._castlingRights;
+    _enPassant = other._enPassant;
+    _sideToMove = other._sideToMove;
+    _key = other._key;
 }
 
 /**
- * @brief places all pieces in the matrix according to their positions and updates the white / black
- * kings' pointers. assumes: sets of white / black pieces are already updated.
- * @param color - color of set: WHITE or BLACK
+ * @brief frees all pieces on the board and empties it.
  */
-void Board::_setUpPieces(int color)
+void Board::_deletePieces()
 {
-    vector<Piece*>& pieces = _getPieces(color);
-    for (auto piece: pieces)
+    saveMoves();
+    Bitboard occupied = getOccupancy();
+    while (occupied)
     {
-        _setPiece(piece, piece->getPosition());
-        if (piece->isKing())
-        {
-            color == WHITE ? (_whiteKing = piece): (_blackKing = piece);
-        }
+        Square square = popLsb(occupied);
+        Piece* piece = _board[square];
+        _setPiece(nullptr, square);
+        _pool.free(piece);
     }
 }
 
 /**
- * @brief a constructor for Board.
- * @param isTemp - true if Board is a tempBoard of a different Board; false otherwise.
+ * @brief a constructor for Board. places all pieces in their initial positions.
  */
-Board::Board(bool isTemp)
+Board::Board()
 {
     _createPieces(WHITE);
     _createPieces(BLACK);
-    _setUpPieces(WHITE);
-    _setUpPieces(BLACK);
-    isTemp ? (_tempBoard = nullptr) : (_tempBoard = new Board(true));
+    _key = _computeKey();
 }
 
 /**
@@ -162,116 +234,367 @@ Board::Board(bool isTemp)
  */
 Board::~Board()
 {
-    delete _tempBoard;
-    for (auto piece: _whitePieces)
+    _deletePieces();
+}
+
+/**
+ * @brief a copy constructor for Board. moves made on other since its last save can't be unmade on
+ * the new Board.
+ * @param other - other Board, whose contents are deep-copied and assigned to this Board
+ */
+Board::Board(const Board& other)
+{
+    _copyPieces(other);
+}
+
+/**
+ * @brief assignment operator for Board. moves made on other since its last save can't be unmade
+ * on this Board.
+ * @param other - other Board, whose contents are deep-copied and assigned to this Board
+ * @return this Board
+ */
+Board& Board::operator=(const Board& other)
+{
+    if (this != &other)
     {
-        delete piece;
+        _deletePieces();
+        _copyPieces(other);
     }
-    for (auto piece: _blackPieces)
+    return *this;
+}
+
+/**
+ * @brief parses the piece placement field of a FEN string
+ * @param placement - ranks from the 8th to the 1st separated by '/', e.g. "8/8/8/8/8/8/8/K6k"
+ * @param types - array of BOARD_SQUARES piece types, to which the function assigns the type of the
+ * piece in every occupied square
+ * @param colors - array of BOARD_SQUARES colors, to which the function assigns the color of the
+ * piece in every square: WHITE, BLACK, or 0 if the square is empty
+ * @return true if placement is valid; false otherwise
+ */
+bool Board::_parsePlacement(const string& placement, PieceType types[], int colors[])
+{
+    int file = 0, rank = BOARD_SIZE - 1;
+    for (char c: placement)
     {
-        delete piece;
+        if (c == FEN_RANK_SEPARATOR)
+        {
+            if ((file != BOARD_SIZE) || (rank == 0))
+            {
+                return false;
+            }
+            file = 0;
+            rank--;
+            continue;
+        }
+        if ((c >= '1') && (c <= '0' + BOARD_SIZE))
+        {
+            file += c - '0';
+            if (file > BOARD_SIZE)
+            {
+                return false;
+            }
+            continue;
+        }
+        const char* letter = std::strchr(PIECE_LETTERS, std::tolower(c));
+        if ((c == '\0') || (letter == nullptr) || (file >= BOARD_SIZE))
+        {
+            return false;
+        }
+        Square square = makeSquare(file++, rank);
+        types[square] = PieceType(letter - PIECE_LETTERS);
+        colors[square] = (std::isupper(c) ? WHITE: BLACK);
     }
+    return (file == BOARD_SIZE) && (rank == 0);
 }
 
 /**
- * @brief a copy constructor for Board. assumes: only used to create tempBoards.
- * @param other - other Board, whose contents are deep-copied and assigned to this Board
+ * @brief parses the castling availability field of a FEN string
+ * @param castling - "-" or a combination of "KQkq"
+ * @param types - piece types of the position, indexed by Square
+ * @param colors - colors of the position: WHITE, BLACK, or 0 if the square is empty
+ * @return the castling rights, e.g. WHITE_KINGSIDE | BLACK_QUEENSIDE; -1 if castling is invalid
+ * or names a right whose king or rook isn't on its initial square
  */
-Board::Board(const Board& other) // assume: only used to construct temp board
+int Board::_parseCastlingRights(const string& castling, const PieceType types[], const int colors[])
 {
-    for (auto piece: other._whitePieces)
+    if (castling == FEN_NONE)
     {
-        _whitePieces.push_back(piece->clone());
+        return 0;
     }
-    for (auto piece: other._blackPieces)
+    int rights = 0;
+    for (char c: castling)
     {
-        _blackPieces.push_back(piece->clone());
+        int index = 0;
+        while ((index < CASTLING_RIGHTS_NUM) && (FEN_CASTLING[index] != c))
+        {
+            index++;
+        }
+        if (index == CASTLING_RIGHTS_NUM)
+        {
+            return INVALID_CASTLING;
+        }
+        int color = (std::isupper(c) ? WHITE: BLACK);
+        int backRank = rankOf(color == WHITE ? A1: BLACK_BACK_RANK);
+        bool kingside = (std::toupper(c) == FEN_CASTLING[0]);
+        Square king = makeSquare(KING_FILE, backRank);
+        Square rook = makeSquare(kingside ? KINGSIDE_ROOK_FILE: QUEENSIDE_ROOK_FILE, backRank);
+        if ((colors[king] != color) || (types[king] != KING) || (colors[rook] != color) ||
+            (types[rook] != ROOK))
+        {
+            return INVALID_CASTLING;
+        }
+        rights |= 1 << index;
     }
-    _setUpPieces(WHITE);
-    _setUpPieces(BLACK);
-    _tempBoard = nullptr;
+    return rights;
 }
 
 /**
- * @brief assignment operator for Board.
- * @param other - other Board, whose contents are deep-copied and assigned to this Board
- * @return this Board
+ * @brief sets up Board from a FEN string, e.g. START_FEN. the halfmove clock and fullmove number
+ * fields are optional and ignored. if fen is invalid, Board is left unchanged.
+ * @param fen - Forsyth-Edwards notation of a position
+ * @return true if fen is a valid position (and Board has been set up); false otherwise
  */
-Board& Board::operator=(const Board& other)
+bool Board::setPosition(const string& fen)
 {
-    for (int i = 0; i < BOARD_SIZE; i++)
+    std::istringstream stream(fen);
+    string placement, side, castling, enPassant;
+    if (!(stream >> placement >> side >> castling >> enPassant))
+    {
+        return false;
+    }
+    PieceType types[BOARD_SQUARES] = {};
+    int colors[BOARD_SQUARES] = {};
+    if (!_parsePlacement(placement, types, colors) || ((side != FEN_WHITE) && (side != FEN_BLACK)))
+    {
+        return false;
+    }
+    int sideToMove = (side == FEN_WHITE ? WHITE: BLACK);
+    int castlingRights = _parseCastlingRights(castling, types, colors);
+    if (castlingRights == INVALID_CASTLING)
+    {
+        return false;
+    }
+
+    Square enPassantSquare = NO_SQUARE;
+    if (enPassant != FEN_NONE)
     {
-        for (int j = 0; j < BOARD_SIZE; j++)
+        enPassant[FILE_INDEX] = char(std::toupper(enPassant[FILE_INDEX]));
+        enPassantSquare = parseSquare(enPassant);
+        int enPassantRank = (sideToMove == WHITE ? WHITE_EN_PASSANT_RANK: BLACK_EN_PASSANT_RANK);
+        if ((enPassantSquare == NO_SQUARE) || (rankOf(enPassantSquare) != enPassantRank))
+        {
+            return false;
+        }
+        auto pawn = Square(enPassantSquare - BOARD_SIZE * sideToMove);
+        if ((colors[pawn] != sideToMove * REVERSE) || (types[pawn] != PAWN))
         {
-            _board[i][j] = nullptr;
+            return false;
         }
+        bool canCapture = false;
+        Bitboard capturers = pawnAttacks(sideToMove * REVERSE, enPassantSquare);
+        while (capturers)
+        {
+            Square capturer = popLsb(capturers);
+            canCapture |= (colors[capturer] == sideToMove) && (types[capturer] == PAWN);
+        }
+        enPassantSquare = (canCapture ? enPassantSquare: NO_SQUARE);
     }
-    for (auto piece: _whitePieces)
+
+    int pieceNum[COLOR_NUM] = {}, kingNum[COLOR_NUM] = {};
+    for (int square = 0; square < BOARD_SQUARES; square++)
     {
-        delete piece;
+        if (colors[square] == 0)
+        {
+            continue;
+        }
+        int color = colorIndex(colors[square]);
+        pieceNum[color]++;
+        kingNum[color] += (types[square] == KING);
+        int rank = rankOf(Square(square));
+        if ((types[square] == PAWN) && ((rank == 0) || (rank == BOARD_SIZE - 1)))
+        {
+            return false;
+        }
     }
-    _whitePieces.clear();
-    for (auto piece: _blackPieces)
+    for (int color = 0; color < COLOR_NUM; color++)
     {
-        delete piece;
+        if ((pieceNum[color] > MAX_PIECES) || (kingNum[color] != 1))
+        {
+            return false;
+        }
     }
-    _blackPieces.clear();
 
-    for (auto piece: other._whitePieces)
+    _deletePieces();
+    for (int square = 0; square < BOARD_SQUARES; square++)
     {
-        _whitePieces.push_back(piece->clone());
+        if (colors[square] != 0)
+        {
+            _setPiece(_createPiece(types[square], colors[square], Square(square)), Square(square));
+        }
     }
-    for (auto piece: other._blackPieces)
+    _castlingRights = castlingRights;
+    _enPassant = enPassantSquare;
+    _sideToMove = sideToMove;
+    _key = _computeKey();
+    return true;
+}
+
+/**
+ * @brief returns the squares of the rook taking part in a castling move
+ * @param move - a castling move
+ * @param rookSrc - non-const ref, to which the function assigns the rook's square before the move.
+ * @param rookDest - non-const ref, to which the function assigns the rook's square after the move.
+ */
+void Board::getCastlingRook(Move move, Square &rookSrc, Square &rookDest)
+{
+    bool kingside = (move.getFlags() == KING_CASTLE);
+    rookSrc = makeSquare(kingside ? KINGSIDE_ROOK_FILE: QUEENSIDE_ROOK_FILE, rankOf(move.getSrc()));
+    rookDest = Square((move.getSrc() + move.getDest()) / 2); // the square the king passes through
+}
+
+/**
+ * @brief returns the square of the piece captured by a move
+ * @param move - a move
+ * @param color - color of the player making the move: WHITE or BLACK
+ * @return the move's destination, or the square behind it if the move captures en passant
+ */
+Square Board::getCapturedSquare(Move move, int color)
+{
+    if (move.getFlags() == EN_PASSANT)
     {
-        _blackPieces.push_back(piece->clone());
+        return Square(move.getDest() - color * BOARD_SIZE);
     }
-    _setUpPieces(WHITE);
-    _setUpPieces(BLACK);
-    return *this;
+    return move.getDest();
 }
 
 /**
- * @brief makes a move on Board. assumes: move is legal
- * @param src - a square on the board, e.g. "A1", representing the position of the piece making
- * the move
- * @param dest - a square on the board, e.g. "A1", representing the destination of the piece
- * making the move
+ * @brief makes a move on Board, so that it can later be unmade. assumes: move is pseudo-legal and
+ * less than MAX_HISTORY moves were made since the last save.
+ * @param move - the move to be made
  */
-void Board::tempMove(const string& src, const string& dest)
+void Board::makeMove(Move move)
 {
-    Piece* destPiece = _tempBoard->_getPiece(dest);
-    if (destPiece != nullptr)
+    Square src = move.getSrc(), dest = move.getDest();
+    Square capturedSquare = getCapturedSquare(move, _sideToMove);
+    Piece* piece = _board[src];
+
+    UndoRecord& record = _history[_historySize++];
+    record.move = move;
+    record.captured = _board[capturedSquare];
+    record.promoted = nullptr;
+    record.castlingRights = _castlingRights;
+    record.enPassant = _enPassant;
+    record.key = _key;
+
+    _setPiece(nullptr, capturedSquare);
+    _setPiece(nullptr, src);
+    if (move.isPromotion())
+    {
+        record.promoted = piece;
+        piece = _createPiece(move.getPromotionType(), piece->getColor(), dest);
+    }
+    _movePiece(piece, dest);
+
+    if (move.isCastling())
     {
-        _tempBoard->_removePiece(dest);
+        Square rookSrc, rookDest;
+        getCastlingRook(move, rookSrc, rookDest);
+        Piece* rook = _board[rookSrc];
+        _setPiece(nullptr, rookSrc);
+        _movePiece(rook, rookDest);
     }
-    Piece* srcPiece = _tempBoard->_getPiece(src);
-    _tempBoard->_setPiece(nullptr, src);
-    _tempBoard->_movePiece(srcPiece, dest);
+    _key ^= castlingKey(_castlingRights) ^ enPassantKey(_enPassant) ^ sideKey(_sideToMove);
+    _castlingRights &= CASTLING_MASKS[src] & CASTLING_MASKS[dest];
+    _enPassant = NO_SQUARE;
+    if (move.getFlags() == DOUBLE_PAWN_PUSH)
+    {
+        auto skipped = Square((src + dest) / 2);
+        if (pawnAttacks(_sideToMove, skipped) & getPieces(_sideToMove * REVERSE, PAWN))
+        {
+            _enPassant = skipped;
+        }
+    }
+    _sideToMove *= REVERSE;
+    _key ^= castlingKey(_castlingRights) ^ enPassantKey(_enPassant) ^ sideKey(_sideToMove);
 }
 
 /**
- * @brief promotes the given piece to queen. assumes: promotion is legal and piece is not
- * nullptr.
- * @param piece - the piece to promote.
+ * @brief passes the turn to the opponent without moving (a null move), so that it can later be
+ * unmade like a move. assumes: the player to move isn't in check and less than MAX_HISTORY moves
+ * were made since the last save.
  */
-void Board::tempPromote(Piece* piece) // assume: not nullptr
+void Board::makeNullMove()
 {
-    string position = piece->getPosition();
-    int color = piece->getColor();
-    vector<Piece*>& pieces = _tempBoard->_getPieces(color);
+    UndoRecord& record = _history[_historySize++];
+    record.move = Move();
+    record.captured = nullptr;
+    record.promoted = nullptr;
+    record.castlingRights = _castlingRights;
+    record.enPassant = _enPassant;
+    record.key = _key;
+
+    _key ^= enPassantKey(_enPassant) ^ sideKey(_sideToMove);
+    _enPassant = NO_SQUARE;
+    _sideToMove *= REVERSE;
+    _key ^= sideKey(_sideToMove);
+}
 
-    _tempBoard->_removePiece(position);
-    auto queen = new Queen(color, position);
-    pieces.push_back((Piece*)queen);
-    _tempBoard->_movePiece(queen, position);
+/**
+ * @brief unmakes the latest move or null move made on Board. assumes: a move was made since the
+ * last save.
+ */
+void Board::unmakeMove()
+{
+    const UndoRecord& record = _history[--_historySize];
+    Move move = record.move;
+    _sideToMove *= REVERSE;
+    if (move.isNull())
+    {
+        _enPassant = record.enPassant;
+        _key = record.key;
+        return;
+    }
+    Square src = move.getSrc(), dest = move.getDest();
+    Piece* piece = _board[dest];
+
+    if (move.isCastling())
+    {
+        Square rookSrc, rookDest;
+        getCastlingRook(move, rookSrc, rookDest);
+        Piece* rook = _board[rookDest];
+        _setPiece(nullptr, rookDest);
+        _movePiece(rook, rookSrc);
+    }
+
+    _setPiece(nullptr, dest);
+    if (record.captured != nullptr)
+    {
+        _setPiece(record.captured, getCapturedSquare(move, _sideToMove));
+    }
+    if (record.promoted != nullptr)
+    {
+        _pool.free(piece);
+        piece = record.promoted;
+    }
+    _movePiece(piece, src);
+    _castlingRights = record.castlingRights;
+    _enPassant = record.enPassant;
+    _key = record.key;
 }
 
 /**
- * @brief saves Board up to latest move
+ * @brief saves Board up to latest move: the moves made since the last save can no longer be
+ * unmade, and the pieces they captured are freed.
  */
 void Board::saveMoves()
 {
-    *this = *_tempBoard;
+    for (int i = 0; i < _historySize; i++)
+    {
+        _pool.free(_history[i].captured);
+        _pool.free(_history[i].promoted);
+    }
+    _historySize = 0;
 }
 
 /**
@@ -279,20 +602,37 @@ void Board::saveMoves()
  */
 void Board::undoMoves()
 {
-    *_tempBoard = *this;
+    while (_historySize > 0)
+    {
+        unmakeMove();
+    }
+}
+
+/**
+ * @brief computes the hash key of the position from scratch
+ * @return the hash key of the position
+ */
+Key Board::_computeKey() const
+{
+    Key key = castlingKey(_castlingRights) ^ enPassantKey(_enPassant) ^ sideKey(_sideToMove);
+    Bitboard occupied = getOccupancy();
+    while (occupied)
+    {
+        Square square = popLsb(occupied);
+        key ^= pieceKey(_board[square]->getColor(), _board[square]->getType(), square);
+    }
+    return key;
 }
 
 /**
- * @brief print the square located at the given position in the matrix
- * @param position - a square in the matrix, e.g. "A1", which is to be printed.
+ * @brief print the square located at the given position on the board
+ * @param position - a square on the board, e.g. A1, which is to be printed.
  */
-void Board::_printSquare(const string &position) const
+void Board::_printSquare(Square position) const
 {
-    Piece* piece = _getPiece(position);
-    int fileIndex = position[FILE_INDEX] - MIN_FILE;
-    int rankIndex = position[RANK_INDEX] - MIN_RANK;
+    Piece* piece = getPiece(position);
 
-    string squareColor = ((fileIndex + rankIndex) % SQUARE_COLOR_NUM == 0) ?
+    string squareColor = ((fileOf(position) + rankOf(position)) % SQUARE_COLOR_NUM == 0) ?
                          PRINT_GREEN : PRINT_BLUE;
     string textColor = (piece != nullptr ?
                         (piece->getColor() == WHITE ? PRINT_WHITE : PRINT_BLACK): PRINT_DEFATULT);
@@ -302,9 +642,9 @@ void Board::_printSquare(const string &position) const
 }
 
 /**
- * @brief prints the matrix
+ * @brief prints the Board
  */
-void Board::_print() const
+void Board::print() const
 {
     std::cout << SPACE << SPACE;
     char filePosition, rankPosition;
@@ -314,14 +654,12 @@ void Board::_print() const
     }
     std::cout << std::endl << std::endl;
 
-    string position;
     for (rankPosition = MAX_RANK; rankPosition >= MIN_RANK; rankPosition--)
     {
         std::cout << rankPosition << SPACE;
         for (filePosition = MIN_FILE; filePosition <= MAX_FILE; filePosition++)
         {
-            position = string(1, filePosition) + string(1, rankPosition);
-            _printSquare(position);
+            _printSquare(makeSquare(filePosition - MIN_FILE, rankPosition - MIN_RANK));
         }
         std::cout << SPACE << rankPosition << std::endl;
     }
@@ -335,51 +673,273 @@ void Board::_print() const
 }
 
 /**
- * @brief checks if the given position is a square on the Board.
- * @param position -  a string in the format <char><int>
- * @return true if position is a square on the board, false otherwise
+ * @brief returns the piece that's in square <position> on the Board. the piece lives until it is
+ * captured and the capture is saved.
+ * @param position - a square on the board, e.g. A1, representing the position from which a
+ * piece is retrieved.
+ * @return the retrieved piece; nullptr if the given square on the board is empty.
  */
-bool Board::isInBoard(const string& position)
+Piece* Board::getPiece(Square position) const
 {
-    return (position[RANK_INDEX] >= MIN_RANK) && (position[RANK_INDEX] <= MAX_RANK) &&
-           (position[FILE_INDEX] >= MIN_FILE) && (position[FILE_INDEX] <= MAX_FILE);
+    return _board[position];
 }
 
 /**
- * @brief returns the piece that's in square <position> on the Board. the piece lives until next
- * call to saveMoves() or undoMoves()
- * @param position - a square on the board, e.g. "A1", representing the position from which a
- * piece is retrieved.
+ * @brief returns the squares occupied by pieces of the given color and type
+ * @param color - color of pieces: WHITE or BLACK
+ * @param type - type of pieces, e.g. ROOK
+ * @return bitboard of the pieces' squares
  */
-Piece* Board::getTempPiece(const string& position) const
+Bitboard Board::getPieces(int color, PieceType type) const
 {
-    return _tempBoard->_getPiece(position);
+    return _pieceMasks[colorIndex(color)][type];
 }
 
 /**
- * @brief returns the set of pieces in the given color
- * @param color - color of set: WHITE or BLACK
+ * @brief returns the squares occupied by pieces of the given color
+ * @param color - color of pieces: WHITE or BLACK
+ * @return bitboard of the pieces' squares
+ */
+Bitboard Board::getOccupancy(int color) const
+{
+    return _colorMasks[colorIndex(color)];
+}
+
+/**
+ * @brief returns the squares occupied by any piece
+ * @return bitboard of all occupied squares
+ */
+Bitboard Board::getOccupancy() const
+{
+    return _colorMasks[colorIndex(WHITE)] | _colorMasks[colorIndex(BLACK)];
+}
+
+/**
+ * @brief returns the squares attacked by the pieces of the given color
+ * @param color - color of attacking pieces: WHITE or BLACK
+ * @return bitboard of all squares attacked by color
+ */
+Bitboard Board::getAttacks(int color) const
+{
+    Bitboard occupied = getOccupancy(), attacks = EMPTY_BITBOARD;
+    for (int type = PAWN; type <= KING; type++)
+    {
+        Bitboard pieces = getPieces(color, PieceType(type));
+        while (pieces)
+        {
+            attacks |= pieceAttacks(PieceType(type), color, popLsb(pieces), occupied);
+        }
+    }
+    return attacks;
+}
+
+/**
+ * @brief checks whether a square is attacked by the pieces of the given color. looks outward from
+ * the square as each piece type, i.e. a "super-piece", and stops at the first attacker.
+ * @param square - a square on the board, e.g. A1
+ * @param byColor - color of attacking pieces: WHITE or BLACK
+ * @return true if a piece of byColor attacks square; false otherwise
+ */
+bool Board::isAttacked(Square square, int byColor) const
+{
+    Bitboard queens = getPieces(byColor, QUEEN), occupied = getOccupancy();
+    return (pawnAttacks(byColor * REVERSE, square) & getPieces(byColor, PAWN)) ||
+           (knightAttacks(square) & getPieces(byColor, KNIGHT)) ||
+           (bishopAttacks(square, occupied) & (getPieces(byColor, BISHOP) | queens)) ||
+           (rookAttacks(square, occupied) & (getPieces(byColor, ROOK) | queens)) ||
+           (kingAttacks(square) & getPieces(byColor, KING));
+}
+
+/**
+ * @brief returns the pieces of both colors attacking a square, given an occupancy that may differ
+ * from Board's, e.g. to see through a piece about to move.
+ * @param square - a square on the board, e.g. A1
+ * @param occupied - bitboard of the squares that block sliding pieces
+ * @return bitboard of the pieces attacking square
+ */
+Bitboard Board::getAttackersTo(Square square, Bitboard occupied) const
+{
+    Bitboard queens = getPieces(WHITE, QUEEN) | getPieces(BLACK, QUEEN);
+    Bitboard bishops = getPieces(WHITE, BISHOP) | getPieces(BLACK, BISHOP) | queens;
+    Bitboard rooks = getPieces(WHITE, ROOK) | getPieces(BLACK, ROOK) | queens;
+    return (pawnAttacks(BLACK, square) & getPieces(WHITE, PAWN)) |
+           (pawnAttacks(WHITE, square) & getPieces(BLACK, PAWN)) |
+           (knightAttacks(square) & (getPieces(WHITE, KNIGHT) | getPieces(BLACK, KNIGHT))) |
+           (bishopAttacks(square, occupied) & bishops) |
+           (rookAttacks(square, occupied) & rooks) |
+           (kingAttacks(square) & (getPieces(WHITE, KING) | getPieces(BLACK, KING)));
+}
+
+/**
+ * @brief returns the opponent's pieces giving check to the given player
+ * @param color - color of the player: WHITE or BLACK
+ * @return bitboard of the pieces attacking color's king
+ */
+Bitboard Board::getCheckers(int color) const
+{
+    Square king = lsb(getPieces(color, KING));
+    return getAttackersTo(king, getOccupancy()) & getOccupancy(color * REVERSE);
+}
+
+/**
+ * @brief returns the given player's pieces that are absolutely pinned, i.e. that are the only
+ * piece between their king and an opponent's slider attacking along that line.
+ * @param color - color of the player: WHITE or BLACK
+ * @return bitboard of color's pinned pieces
+ */
+Bitboard Board::getPinned(int color) const
+{
+    int opponent = color * REVERSE;
+    Square king = lsb(getPieces(color, KING));
+    Bitboard queens = getPieces(opponent, QUEEN), occupied = getOccupancy();
+    Bitboard snipers = (rookAttacks(king, EMPTY_BITBOARD) & (getPieces(opponent, ROOK) | queens)) |
+            (bishopAttacks(king, EMPTY_BITBOARD) & (getPieces(opponent, BISHOP) | queens));
+    Bitboard pinned = EMPTY_BITBOARD;
+    while (snipers)
+    {
+        Bitboard blockers = betweenMask(king, popLsb(snipers)) & occupied;
+        if ((popCount(blockers) == 1) && (blockers & getOccupancy(color)))
+        {
+            pinned |= blockers;
+        }
+    }
+    return pinned;
+}
+
+/**
+ * @brief checks whether a pseudo-legal move leaves the moving player's king out of check, without
+ * making it. castling moves are assumed to pass through unattacked squares.
+ * @param move - the move. assumes: move is pseudo-legal.
+ * @param checkers - getCheckers() of the moving player
+ * @param pinned - getPinned() of the moving player
+ * @return true if move is legal; false otherwise
  */
-vector<Piece*>& Board::getTempPieces(int color)
+bool Board::isLegal(Move move, Bitboard checkers, Bitboard pinned) const
 {
-    return _tempBoard->_getPieces(color);
+    Square src = move.getSrc(), dest = move.getDest();
+    int color = _board[src]->getColor();
+    Square king = lsb(getPieces(color, KING));
+    Bitboard opponents = getOccupancy(color * REVERSE);
+    if (src == king)
+    {
+        // a king stepping away from a slider along its line is still attacked by it, so the
+        // king doesn't block its own destination. the castling rook blocks that line anyway.
+        Bitboard occupied = getOccupancy() ^ (move.isCastling() ? EMPTY_BITBOARD: squareMask(src));
+        return !(getAttackersTo(dest, occupied) & opponents);
+    }
+    if (move.getFlags() == EN_PASSANT)
+    {
+        // the captured pawn and the capturing one both leave the king's lines
+        Square captured = getCapturedSquare(move, color);
+        Bitboard occupied = (getOccupancy() ^ squareMask(src) ^ squareMask(captured)) |
+                            squareMask(dest);
+        return !(getAttackersTo(king, occupied) & opponents & ~squareMask(captured));
+    }
+    if (checkers)
+    {
+        // a single check is evaded by capturing the checker or blocking its line; a double check
+        // only by a king move
+        if ((checkers & (checkers - 1)) ||
+            !((checkers | betweenMask(king, lsb(checkers))) & squareMask(dest)))
+        {
+            return false;
+        }
+    }
+    // a pinned piece may only move along the line through its king and its pinner
+    return !(pinned & squareMask(src)) || (betweenMask(king, dest) & squareMask(src)) ||
+           (betweenMask(king, src) & squareMask(dest));
 }
 
 /**
- * @brief returns the king in the given color. the king lives until next call to saveMoves() or
- * undoMoves()
-  * @param color - color of king: WHITE or BLACK
+ * @brief returns the king in the given color.
+ * @param color - color of king: WHITE or BLACK
  * @return the king in the given color
  */
-Piece* Board::getTempKing(int color) const
+Piece* Board::getKing(int color) const
+{
+    return _board[lsb(getPieces(color, KING))];
+}
+
+/**
+ * @brief checks whether the given player may still castle to the given side, i.e. neither its king
+ * nor the rook on that side have moved or been captured.
+ * @param color - color of player: WHITE or BLACK
+ * @param kingside - true for kingside castling; false for queenside castling
+ * @return true if the castling right is still available; false otherwise
+ */
+bool Board::canCastle(int color, bool kingside) const
+{
+    int right = (color == WHITE ? (kingside ? WHITE_KINGSIDE: WHITE_QUEENSIDE):
+                 (kingside ? BLACK_KINGSIDE: BLACK_QUEENSIDE));
+    return (_castlingRights & right) != 0;
+}
+
+/**
+ * @brief checks whether the given player is in check
+ * @param color - color of the given player: WHITE or BLACK
+ * @return true if the given player is in check; false otherwise
+ */
+bool Board::isInCheck(int color) const
+{
+    return isAttacked(lsb(getPieces(color, KING)), color * REVERSE);
+}
+
+/**
+ * @brief returns the player whose turn it is
+ * @return color of the player to move: WHITE or BLACK
+ */
+int Board::getSideToMove() const
+{
+    return _sideToMove;
+}
+
+/**
+ * @brief returns the en passant square, i.e. the square a pawn skipped over in the last move
+ * @return the square behind a pawn that has just moved two squares; NO_SQUARE if there is none or
+ * no enemy pawn can capture it
+ */
+Square Board::getEnPassant() const
+{
+    return _enPassant;
+}
+
+/**
+ * @brief returns the Zobrist hash key of the position, covering the piece placement, the side to
+ * move, the castling rights and the en passant square.
+ * @return the hash key of the position
+ */
+Key Board::getKey() const
+{
+    return _key;
+}
+
+/**
+ * @brief returns the Zobrist hash key of the pawn placement alone, e.g. for caching the evaluation
+ * of the pawn structure
+ * @return the hash key of the pawns; 0 if there are none
+ */
+Key Board::getPawnKey() const
+{
+    return _pawnKey;
+}
+
+/**
+ * @brief returns the sum of the values and piece-square bonuses of all pieces in a phase of the
+ * game
+ * @param phase - MIDGAME or ENDGAME
+ * @return the score of the position in phase in centipawns, from white's point of view
+ */
+int Board::getPhaseScore(GamePhase phase) const
 {
-    return _tempBoard->_getKing(color);
+    return _phaseScores[phase];
 }
 
 /**
- * @brief prints the (updated) Board
+ * @brief returns the game phase of the position: the sum of the phase weights of all pieces, which
+ * is MAX_PHASE in the starting position and 0 once only kings and pawns are left
+ * @return the game phase; may exceed MAX_PHASE after promotions
  */
-void Board::tempPrint() const
+int Board::getPhase() const
 {
-    _tempBoard->_print();
+    return _phase;
 }
\ No newline at end of file
@@ -5,26 +5,47 @@
 
 // ------------------------- includes --------------------------
 
-#include <algorithm> // std::remove
-#include "Rook.h"
-#include "Bishop.h"
-#include "Queen.h"
-#include "Knight.h"
-#include "Pawn.h"
-#include "King.h"
+#include "PiecePool.h"
+#include "Bitboard.h"
+#include "Move.h"
+#include "Zobrist.h"
+#include "PieceSquare.h"
 
 // --------------------- const definitions ---------------------
 
-// max rank in board
-constexpr char MAX_RANK = '8';
-// min rank in board
-constexpr char MIN_RANK = '1';
-// max file in board
-constexpr char MAX_FILE = 'H';
-// min file in board
-constexpr char MIN_FILE = 'A';
-// number of ranks / files in board
-constexpr int BOARD_SIZE = 8;
+// castling right: white kingside
+constexpr int WHITE_KINGSIDE = 1;
+// castling right: white queenside
+constexpr int WHITE_QUEENSIDE = 2;
+// castling right: black kingside
+constexpr int BLACK_KINGSIDE = 4;
+// castling right: black queenside
+constexpr int BLACK_QUEENSIDE = 8;
+// all castling rights
+constexpr int ALL_CASTLING = WHITE_KINGSIDE | WHITE_QUEENSIDE | BLACK_KINGSIDE | BLACK_QUEENSIDE;
+// file of the queenside rooks' initial squares
+constexpr int QUEENSIDE_ROOK_FILE = 0;
+// file of the kingside rooks' initial squares
+constexpr int KINGSIDE_ROOK_FILE = BOARD_SIZE - 1;
+// max number of moves that can be made on a Board between two saves
+constexpr int MAX_HISTORY = 256;
+// FEN of the initial position
+constexpr auto START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+// --------------------- struct declaration --------------------
+
+/**
+ * the state of a Board that a move destroys, saved so that the move can be unmade.
+ */
+struct UndoRecord
+{
+    Move move; /** the move that was made; a null move if the player passed */
+    Piece* captured; /** the piece captured by the move; nullptr if none */
+    Piece* promoted; /** the pawn replaced by a promotion; nullptr if none */
+    int castlingRights; /** castling rights before the move */
+    Square enPassant; /** en passant square before the move */
+    Key key; /** hash key before the move */
+};
 
 // --------------------- class declaration ---------------------
 
@@ -34,98 +55,118 @@ constexpr int BOARD_SIZE = 8;
 class Board
 {
 private:
-    /** matrix representing the actual chess board */
-    Piece* _board[BOARD_SIZE][BOARD_SIZE] = {nullptr};
-    /** set of white pieces on the board */
-    vector<Piece*> _whitePieces;
-    /** set of black pieces on the board*/
-    vector<Piece*> _blackPieces;
-    /** the white king */
-    Piece* _whiteKing;
-    /** the black king */
-    Piece* _blackKing;
-    /**
-     * a Board representing a modified (updated) version of this Board. Moves are made on
-     * tempBoard, while this Board represents the last saved version of tempBoard.
-     */
-    Board* _tempBoard;  // tempBoard does not point to another Board
+    /** arena of the pieces on the board and of those that moves can still restore */
+    PiecePool _pool;
+    /** mailbox representing the actual chess board, indexed by Square */
+    Piece* _board[BOARD_SQUARES] = {nullptr};
+    /** occupancy of every piece type in every color, indexed by colorIndex() and PieceType */
+    Bitboard _pieceMasks[COLOR_NUM][PIECE_TYPE_NUM] = {};
+    /** occupancy of every color, indexed by colorIndex() */
+    Bitboard _colorMasks[COLOR_NUM] = {};
+    /** castling rights still available, e.g. WHITE_KINGSIDE | BLACK_QUEENSIDE */
+    int _castlingRights = ALL_CASTLING;
+    /** square a pawn skipped over in the last move; NO_SQUARE if it didn't move two squares or
+     * no enemy pawn can capture it en passant */
+    Square _enPassant = NO_SQUARE;
+    /** color of the player to move: WHITE or BLACK */
+    int _sideToMove = WHITE;
+    /** hash key of the position, updated incrementally by every change */
+    Key _key = 0;
+    /** hash key of the pawns alone, updated incrementally by every change */
+    Key _pawnKey = 0;
+    /** sum of the piece-square scores of all pieces in every phase, indexed by GamePhase, from
+     * white's point of view; updated incrementally by every change */
+    int _phaseScores[PHASE_NUM] = {};
+    /** sum of the phase weights of all pieces, updated incrementally by every change */
+    int _phase = 0;
+    /** undo records of the moves made since the last save, oldest first */
+    UndoRecord _history[MAX_HISTORY];
+    /** number of moves made since the last save */
+    int _historySize = 0;
 
     /**
-     * @brief generates all pieces in the white / black set with their initial positions. allocates
-     * memory in freestore.
+     * @brief generates all pieces in the white / black set with their initial positions and places
+     * them on the board. allocates memory in the pool.
      * @param color - color of set: WHITE or BLACK
      */
     void _createPieces(int color);
 
     /**
-     * @brief places all pieces in the matrix according to their positions and updates the white /
-     * black kings' pointers. assumes: sets of white / black pieces are already updated.
-     * @param color - color of set: WHITE or BLACK
+     * @brief generates a piece of the given type. allocates memory in the pool.
+     * @param type - type of the piece, e.g. ROOK
+     * @param color - color of the piece: WHITE or BLACK
+     * @param position - initial position of the piece on the board, e.g. A1
+     * @return the new piece
      */
-    void _setUpPieces(int color);
+    Piece* _createPiece(PieceType type, int color, Square position);
 
     /**
-     * @brief places a piece in the given position in the matrix
-     * @param piece - the piece to be placed
-     * @param position - a square in the matrix, e.g. "A1", representing the piece's new position.
+     * @brief deep-copies all pieces of another Board onto this (empty) Board.
+     * @param other - other Board, whose pieces are copied
      */
-    void _setPiece(Piece *piece, const string &position);
+    void _copyPieces(const Board& other);
 
     /**
-     * @brief places a piece in the given position in the matrix, and updates that piece's position.
-     * @param piece - the piece to be moved. assumes: piece isn't nullptr.
-     * @param position - a square in the matrix, e.g. "A1", representing the piece's new position.
+     * @brief frees all pieces on the board and empties it.
      */
-    void _movePiece(Piece *piece, const string &position);
+    void _deletePieces();
 
     /**
-     * @brief remove the piece placed in the given position from the matrix and from its respective
-     * set. frees memory in freestore.
-     * @param position - a square in the matrix, e.g. "A1", representing the position from which a
-     * piece is to be removed.
+     * @brief places a piece in the given square of the mailbox and updates the occupancy masks,
+     * the hash keys and the piece-square scores.
+     * whatever piece was in the square before is only unlinked from the board, not freed.
+     * @param piece - the piece to be placed; nullptr to empty the square
+     * @param square - a square on the board
      */
-    void _removePiece(const string &position);
+    void _setPiece(Piece *piece, Square square);
 
     /**
-     * @brief returns the piece that's in square <position> in the matrix
-     * @param position - a square in the matrix, e.g. "A1", representing the position from which a
-     * piece is retrieved.
-     * @return the retrieved piece; nullptr if the given square in the matrix is empty.
+     * @brief places a piece in the given square on the board, and updates that piece's position.
+     * @param piece - the piece to be moved. assumes: piece isn't nullptr.
+     * @param square - a square on the board, representing the piece's new position.
      */
-    Piece* _getPiece(const string &position) const;
+    void _movePiece(Piece *piece, Square square);
 
     /**
-     * @brief returns the set of pieces in the given color
-     * @param color - color of set: WHITE or BLACK
-     * @return the set of pieces in the given color.
+     * @brief parses the piece placement field of a FEN string
+     * @param placement - ranks from the 8th to the 1st separated by '/', e.g. "8/8/8/8/8/8/8/K6k"
+     * @param types - array of BOARD_SQUARES piece types, to which the function assigns the type of
+     * the piece in every occupied square
+     * @param colors - array of BOARD_SQUARES colors, to which the function assigns the color of
+     * the piece in every square: WHITE, BLACK, or 0 if the square is empty
+     * @return true if placement is valid; false otherwise
      */
-    vector<Piece*>& _getPieces(int color);
+    static bool _parsePlacement(const string& placement, PieceType types[], int colors[]);
 
     /**
-     * @brief returns the king in the given color
-      * @param color - color of king: WHITE or BLACK
-     * @return the king in the given color
+     * @brief parses the castling availability field of a FEN string
+     * @param castling - "-" or a combination of "KQkq"
+     * @param types - piece types of the position, indexed by Square
+     * @param colors - colors of the position: WHITE, BLACK, or 0 if the square is empty
+     * @return the castling rights, e.g. WHITE_KINGSIDE | BLACK_QUEENSIDE; -1 if castling is
+     * invalid or names a right whose king or rook isn't on its initial square
      */
-    Piece* _getKing(int color) const;
+    static int _parseCastlingRights(const string& castling, const PieceType types[],
+                                    const int colors[]);
 
     /**
-     * @brief print the square located at the given position in the matrix
-     * @param position - a square in the matrix, e.g. "A1", which is to be printed.
+     * @brief computes the hash key of the position from scratch
+     * @return the hash key of the position
      */
-    void _printSquare(const string &position) const;
+    Key _computeKey() const;
 
     /**
-     * @brief prints the matrix
+     * @brief print the square located at the given position on the board
+     * @param position - a square on the board, e.g. A1, which is to be printed.
      */
-    void _print() const;
+    void _printSquare(Square position) const;
 
 public:
 
     /**
-     * @brief a constructor for Board.
-     * @param isTemp - true if Board is a tempBoard of a different Board; false otherwise.
+     * @brief a constructor for Board. places all pieces in their initial positions.
      */
-    explicit Board(bool isTemp = false);
+    Board();
 
     /**
      * @brief a destructor for Board.
@@ -133,29 +174,51 @@ public:
     ~Board();
 
     /**
-     * @brief assignment operator for Board.
+     * @brief assignment operator for Board. moves made on other since its last save can't be
+     * unmade on this Board.
      * @param other - other Board, whose contents are deep-copied and assigned to this Board
      * @return this Board
      */
-    Board& operator=(const Board& other); // (excluding _tempBoard)
+    Board& operator=(const Board& other);
 
     /**
-     * @brief a copy constructor for Board. assumes: only used to create tempBoards.
+     * @brief a copy constructor for Board. moves made on other since its last save can't be
+     * unmade on the new Board.
      * @param other - other Board, whose contents are deep-copied and assigned to this Board
      */
-    Board(const Board& other); // (excluding _tempBoard)
+    Board(const Board& other);
+
+    /**
+     * @brief sets up Board from a FEN string, e.g. START_FEN. the halfmove clock and fullmove
+     * number fields are optional and ignored. if fen is invalid, Board is left unchanged.
+     * @param fen - Forsyth-Edwards notation of a position
+     * @return true if fen is a valid position (and Board has been set up); false otherwise
+     */
+    bool setPosition(const string& fen);
+
+    /**
+     * @brief makes a move on Board, so that it can later be unmade. assumes: move is
+     * pseudo-legal and less than MAX_HISTORY moves were made since the last save.
+     * @param move - the move to be made
+     */
+    void makeMove(Move move);
+
+    /**
+     * @brief passes the turn to the opponent without moving (a null move), so that it can later
+     * be unmade like a move. assumes: the player to move isn't in check and less than
+     * MAX_HISTORY moves were made since the last save.
+     */
+    void makeNullMove();
 
     /**
-     * @brief makes a move on Board. assumes: move is legal
-     * @param src - a square on the board, e.g. "A1", representing the position of the piece making
-     * the move
-     * @param dest - a square on the board, e.g. "A1", representing the destination of the piece
-     * making the move
+     * @brief unmakes the latest move or null move made on Board. assumes: a move was made since
+     * the last save.
      */
-    void tempMove(const string& src, const string& dest);
+    void unmakeMove();
 
     /**
-     * @brief saves Board up to latest move
+     * @brief saves Board up to latest move: the moves made since the last save can no longer be
+     * unmade, and the pieces they captured are freed.
      */
     void saveMoves();
 
@@ -165,45 +228,172 @@ public:
     void undoMoves();
 
     /**
-     * @brief promotes the given piece to queen. assumes: promotion is legal and piece is not
-     * nullptr.
-     * @param piece - the piece to promote.
+     * @brief returns the squares of the rook taking part in a castling move
+     * @param move - a castling move
+     * @param rookSrc - non-const ref, to which the function assigns the rook's square before the
+     * move.
+     * @param rookDest - non-const ref, to which the function assigns the rook's square after the
+     * move.
      */
-    void tempPromote(Piece* piece);
+    static void getCastlingRook(Move move, Square &rookSrc, Square &rookDest);
 
     /**
-     * @brief returns the piece that's in square <position> on the Board. the piece lives until next
-     * call to saveMoves() or undoMoves()
-     * @param position - a square on the board, e.g. "A1", representing the position from which a
+     * @brief returns the square of the piece captured by a move
+     * @param move - a move
+     * @param color - color of the player making the move: WHITE or BLACK
+     * @return the move's destination, or the square behind it if the move captures en passant
+     */
+    static Square getCapturedSquare(Move move, int color);
+
+    /**
+     * @brief returns the piece that's in square <position> on the Board. the piece lives until it
+     * is captured and the capture is saved.
+     * @param position - a square on the board, e.g. A1, representing the position from which a
      * piece is retrieved.
+     * @return the retrieved piece; nullptr if the given square on the board is empty.
      */
-    Piece* getTempPiece(const string& position) const;
+    Piece* getPiece(Square position) const;
 
     /**
-     * @brief returns the set of pieces in the given color
-     * @param color - color of set: WHITE or BLACK
+     * @brief returns the squares occupied by pieces of the given color and type
+     * @param color - color of pieces: WHITE or BLACK
+     * @param type - type of pieces, e.g. ROOK
+     * @return bitboard of the pieces' squares
+     */
+    Bitboard getPieces(int color, PieceType type) const;
+
+    /**
+     * @brief returns the squares occupied by pieces of the given color
+     * @param color - color of pieces: WHITE or BLACK
+     * @return bitboard of the pieces' squares
+     */
+    Bitboard getOccupancy(int color) const;
+
+    /**
+     * @brief returns the squares occupied by any piece
+     * @return bitboard of all occupied squares
+     */
+    Bitboard getOccupancy() const;
+
+    /**
+     * @brief returns the squares attacked by the pieces of the given color
+     * @param color - color of attacking pieces: WHITE or BLACK
+     * @return bitboard of all squares attacked by color
      */
-    vector<Piece*>& getTempPieces(int color);
+    Bitboard getAttacks(int color) const;
 
     /**
-     * @brief returns the king in the given color. the king lives until next call to saveMoves() or
-     * undoMoves()
+     * @brief checks whether a square is attacked by the pieces of the given color. looks outward
+     * from the square as each piece type, i.e. a "super-piece", and stops at the first attacker.
+     * @param square - a square on the board, e.g. A1
+     * @param byColor - color of attacking pieces: WHITE or BLACK
+     * @return true if a piece of byColor attacks square; false otherwise
+     */
+    bool isAttacked(Square square, int byColor) const;
+
+    /**
+     * @brief returns the pieces of both colors attacking a square, given an occupancy that may
+     * differ from Board's, e.g. to see through a piece about to move.
+     * @param square - a square on the board, e.g. A1
+     * @param occupied - bitboard of the squares that block sliding pieces
+     * @return bitboard of the pieces attacking square
+     */
+    Bitboard getAttackersTo(Square square, Bitboard occupied) const;
+
+    /**
+     * @brief returns the opponent's pieces giving check to the given player
+     * @param color - color of the player: WHITE or BLACK
+     * @return bitboard of the pieces attacking color's king
+     */
+    Bitboard getCheckers(int color) const;
+
+    /**
+     * @brief returns the given player's pieces that are absolutely pinned, i.e. that are the only
+     * piece between their king and an opponent's slider attacking along that line.
+     * @param color - color of the player: WHITE or BLACK
+     * @return bitboard of color's pinned pieces
+     */
+    Bitboard getPinned(int color) const;
+
+    /**
+     * @brief checks whether a pseudo-legal move leaves the moving player's king out of check,
+     * without making it. castling moves are assumed to pass through unattacked squares.
+     * @param move - the move. assumes: move is pseudo-legal.
+     * @param checkers - getCheckers() of the moving player
+     * @param pinned - getPinned() of the moving player
+     * @return true if move is legal; false otherwise
+     */
+    bool isLegal(Move move, Bitboard checkers, Bitboard pinned) const;
+
+    /**
+     * @brief returns the king in the given color.
       * @param color - color of king: WHITE or BLACK
      * @return the king in the given color
      */
-    Piece* getTempKing(int color) const;
+    Piece* getKing(int color) const;
+
+    /**
+     * @brief checks whether the given player may still castle to the given side, i.e. neither
+     * its king nor the rook on that side have moved or been captured.
+     * @param color - color of player: WHITE or BLACK
+     * @param kingside - true for kingside castling; false for queenside castling
+     * @return true if the castling right is still available; false otherwise
+     */
+    bool canCastle(int color, bool kingside) const;
+
+    /**
+     * @brief checks whether the given player is in check
+     * @param color - color of the given player: WHITE or BLACK
+     * @return true if the given player is in check; false otherwise
+     */
+    bool isInCheck(int color) const;
+
+    /**
+     * @brief returns the player whose turn it is
+     * @return color of the player to move: WHITE or BLACK
+     */
+    int getSideToMove() const;
+
+    /**
+     * @brief returns the en passant square, i.e. the square a pawn skipped over in the last move
+     * @return the square behind a pawn that has just moved two squares; NO_SQUARE if there is none
+     * or no enemy pawn can capture it
+     */
+    Square getEnPassant() const;
+
+    /**
+     * @brief returns the Zobrist hash key of the position, covering the piece placement, the side
+     * to move, the castling rights and the en passant square.
+     * @return the hash key of the position
+     */
+    Key getKey() const;
+
+    /**
+     * @brief returns the Zobrist hash key of the pawn placement alone, e.g. for caching the
+     * evaluation of the pawn structure
+     * @return the hash key of the pawns; 0 if there are none
+     */
+    Key getPawnKey() const;
+
+    /**
+     * @brief returns the sum of the values and piece-square bonuses of all pieces in a phase of
+     * the game
+     * @param phase - MIDGAME or ENDGAME
+     * @return the score of the position in phase in centipawns, from white's point of view
+     */
+    int getPhaseScore(GamePhase phase) const;
 
     /**
-     * @brief checks if the given position is a square on the Board.
-     * @param position -  a string in the format <char><int>
-     * @return true if position is a square on the board, false otherwise
+     * @brief returns the game phase of the position: the sum of the phase weights of all pieces,
+     * which is MAX_PHASE in the starting position and 0 once only kings and pawns are left
+     * @return the game phase; may exceed MAX_PHASE after promotions
      */
-    static bool isInBoard(const string& position);
+    int getPhase() const;
 
     /**
-     * @brief prints the (updated) Board
+     * @brief prints the Board
      */
-    void tempPrint() const;
+    void print() const;
 };
 
 
@@ -0,0 +1,147 @@
+// Evaluate.cpp
+// This file contains the implementation of the static evaluation
+
+// ------------------------- includes --------------------------
+
+#include "Evaluate.h"
+
+// --------------------- const definitions ---------------------
+
+// endgame bonus of a passed pawn whose next square is empty, indexed by the pawn's rank from its
+// color's side
+constexpr int FREE_PASSED_BONUSES[BOARD_SIZE] = {0, 0, 5, 10, 20, 35, 60, 0};
+
+// value of every piece type in an exchange, indexed by PieceType. the king is worth more than
+// all other pieces, so that it never captures a defended piece.
+constexpr int EXCHANGE_VALUES[PIECE_TYPE_NUM] = {PIECE_VALUES[PAWN], PIECE_VALUES[KNIGHT],
+                                                 PIECE_VALUES[BISHOP], PIECE_VALUES[ROOK],
+                                                 PIECE_VALUES[QUEEN], 20000};
+// max number of captures in an exchange on one square: one per piece on the board, plus 1
+constexpr int MAX_EXCHANGE = 4 * BOARD_SIZE + 1;
+
+// ----------------- function implementation -------------------
+
+/**
+ * @brief evaluates a position statically, i.e. without searching any move: interpolates between
+ * the midgame and endgame scores by the game phase. the piece-square scores are kept up to date by
+ * Board, and the pawn structure scores are cached in a pawn table.
+ * @param board - the position
+ * @param pawnTable - the pawn table of the calling thread
+ * @return score of the position in centipawns, from the point of view of the player to move
+ */
+int evaluate(const Board& board, PawnTable& pawnTable)
+{
+    const PawnEntry& pawns = pawnTable.probe(board);
+    int midgame = board.getPhaseScore(MIDGAME) + pawns.scores[MIDGAME];
+    int endgame = board.getPhaseScore(ENDGAME) + pawns.scores[ENDGAME];
+    // whether a passed pawn can advance depends on the other pieces, so it isn't cached
+    Bitboard passed = pawns.passed;
+    Bitboard occupied = board.getOccupancy();
+    while (passed)
+    {
+        Square square = popLsb(passed);
+        int color = board.getPiece(square)->getColor();
+        if (!(occupied & squareMask(Square(square + BOARD_SIZE * color))))
+        {
+            int relativeRank = (color == WHITE ? rankOf(square): BOARD_SIZE - 1 - rankOf(square));
+            endgame += FREE_PASSED_BONUSES[relativeRank] * color;
+        }
+    }
+    int phase = std::min(board.getPhase(), MAX_PHASE);
+    int score = (midgame * phase + endgame * (MAX_PHASE - phase)) / MAX_PHASE;
+    return score * board.getSideToMove();
+}
+
+/**
+ * @brief returns the least valuable of the given pieces of a player
+ * @param board - the position
+ * @param pieces - a set of pieces
+ * @param color - color of the player: WHITE or BLACK
+ * @param type - non-const ref, to which the function assigns the type of the returned piece
+ * @return bitboard of the least valuable of color's pieces in pieces; EMPTY_BITBOARD if there are
+ * none
+ */
+static Bitboard _leastValuable(const Board& board, Bitboard pieces, int color, PieceType& type)
+{
+    for (int candidate = PAWN; candidate < PIECE_TYPE_NUM; candidate++)
+    {
+        Bitboard found = pieces & board.getPieces(color, PieceType(candidate));
+        if (found)
+        {
+            type = PieceType(candidate);
+            return found & -found;
+        }
+    }
+    return EMPTY_BITBOARD;
+}
+
+/**
+ * @brief evaluates the exchange a move starts on its destination square statically (SEE): both
+ * players keep recapturing there with their least valuable attacker, including those uncovered
+ * behind the pieces that captured, and either may stop when it's ahead. pins are ignored.
+ * @param board - the position
+ * @param move - a pseudo-legal move of the player to move
+ * @return material won by the move's player in centipawns, once the exchange ends; 0 for a quiet
+ * move that can't be captured, negative for a move that loses material
+ */
+int staticExchange(const Board& board, Move move)
+{
+    Square src = move.getSrc(), dest = move.getDest();
+    int color = board.getSideToMove();
+    PieceType type = board.getPiece(src)->getType();
+    Bitboard occupied = board.getOccupancy() ^ squareMask(src);
+    // gains[i] is the material won by the player making the i-th capture, if the exchange ends
+    // there
+    int gains[MAX_EXCHANGE];
+    gains[0] = 0;
+    if (move.getFlags() == EN_PASSANT)
+    {
+        gains[0] = EXCHANGE_VALUES[PAWN];
+        occupied ^= squareMask(Square(dest - BOARD_SIZE * color));
+    }
+    else if (move.isCapture())
+    {
+        gains[0] = EXCHANGE_VALUES[board.getPiece(dest)->getType()];
+    }
+    if (move.isPromotion())
+    {
+        type = move.getPromotionType();
+        gains[0] += EXCHANGE_VALUES[type] - EXCHANGE_VALUES[PAWN];
+    }
+
+    Bitboard diagonals = board.getPieces(WHITE, BISHOP) | board.getPieces(BLACK, BISHOP) |
+                         board.getPieces(WHITE, QUEEN) | board.getPieces(BLACK, QUEEN);
+    Bitboard lines = board.getPieces(WHITE, ROOK) | board.getPieces(BLACK, ROOK) |
+                     board.getPieces(WHITE, QUEEN) | board.getPieces(BLACK, QUEEN);
+    Bitboard attackers = board.getAttackersTo(dest, occupied) & occupied;
+    int depth = 0;
+    PieceType attackerType;
+    while (true)
+    {
+        color *= REVERSE;
+        Bitboard attacker = _leastValuable(board, attackers, color, attackerType);
+        if (!attacker)
+        {
+            break;
+        }
+        // attacker captures the piece on dest, which made the previous capture
+        depth++;
+        gains[depth] = EXCHANGE_VALUES[type] - gains[depth - 1];
+        if (std::max(-gains[depth - 1], gains[depth]) < 0)
+        {
+            // neither capturing nor standing pat changes who's ahead
+            depth--;
+            break;
+        }
+        occupied ^= attacker;
+        attackers = (attackers | (bishopAttacks(dest, occupied) & diagonals) |
+                     (rookAttacks(dest, occupied) & lines)) & occupied;
+        type = attackerType;
+    }
+    while (depth > 0)
+    {
+        depth--;
+        gains[depth] = -std::max(-gains[depth], gains[depth + 1]);
+    }
+    return gains[0];
+}
\ No newline at end of file
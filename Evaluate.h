@@ -0,0 +1,38 @@
+// Evaluate.h
+
+#ifndef CHESS_CPP_EVALUATE_H
+#define CHESS_CPP_EVALUATE_H
+
+// ------------------------- includes --------------------------
+
+#include "PawnTable.h"
+
+// --------------------- const definitions ---------------------
+
+// value of every piece type in centipawns, indexed by PieceType. the king is never traded.
+constexpr int PIECE_VALUES[PIECE_TYPE_NUM] = {100, 320, 330, 500, 900, 0};
+
+// ------------------- function declarations -------------------
+
+/**
+ * @brief evaluates a position statically, i.e. without searching any move: interpolates between
+ * the midgame and endgame scores by the game phase. the piece-square scores are kept up to date by
+ * Board, and the pawn structure scores are cached in a pawn table.
+ * @param board - the position
+ * @param pawnTable - the pawn table of the calling thread
+ * @return score of the position in centipawns, from the point of view of the player to move
+ */
+int evaluate(const Board& board, PawnTable& pawnTable);
+
+/**
+ * @brief evaluates the exchange a move starts on its destination square statically (SEE): both
+ * players keep recapturing there with their least valuable attacker, including those uncovered
+ * behind the pieces that captured, and either may stop when it's ahead. pins are ignored.
+ * @param board - the position
+ * @param move - a pseudo-legal move of the player to move
+ * @return material won by the move's player in centipawns, once the exchange ends; 0 for a quiet
+ * move that can't be captured, negative for a move that loses material
+ */
+int staticExchange(const Board& board, Move move);
+
+#endif //CHESS_CPP_EVALUATE_H
\ No newline at end of file
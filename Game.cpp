@@ -32,18 +32,41 @@ constexpr auto REQUEST_BLACK_PLAYER = "Enter black player name:";
 constexpr auto ILLEGAL_MESSAGE = "\33[37;41millegal move\33[0m";
 // won! message
 constexpr auto WON_MESSAGE = " won!";
+// stalemate message
+constexpr auto STALEMATE_MESSAGE = "Stalemate! It's a draw.";
+// name of the player played by the engine
+constexpr auto ENGINE_NAME = "Engine";
+// engine move message
+constexpr auto ENGINE_MOVE_MESSAGE = " plays ";
 
 
 // ------------------- class implementation --------------------
 
+/**
+ * @brief a constructor for Game
+ * @param engineColor - color of the player played by the engine: WHITE or BLACK; 0 if both
+ * players are human
+ * @param engineLimits - the budget of every engine move
+ * @param tableMegabytes - size of the engine's transposition table, in megabytes
+ * @param engineThreadNum - number of threads searching every engine move
+ */
+Game::Game(int engineColor, const SearchLimits& engineLimits, size_t tableMegabytes,
+           int engineThreadNum):
+        _gameMaster(tableMegabytes), _currentPlayer(WHITE),
+        _isEngine{engineColor == WHITE, engineColor == BLACK}, _engineLimits(engineLimits),
+        _engineThreadNum(engineThreadNum)
+{
+}
+
 /**
  * @brief receives input from the user and parses it. input either represents a regular move on
  * the board, i.e. "A1B1", or a castling move: "o-o-o" or "o-o". assumes: legal format.
  * @param src - non-const ref, to which the function assigns: a square on the board, e.g.
- * "A1", representing the position of the piece making the move. assignment is only in case
- * of regular move.
+ * A1, representing the position of the piece making the move, or NO_SQUARE if the input isn't
+ * a square. assignment is only in case of regular move.
  * @param dest - non-const ref, to which the function assigns: a square on the board, e.g.
- * "A1", representing the destination of the piece. assignment is only in case of regular move.
+ * A1, representing the destination of the piece, or NO_SQUARE if the input isn't a square.
+ * assignment is only in case of regular move.
  * making the move
  * @param isCastling - non-const ref, to which the function assigns: true if the given move
  * is a castling move; false otherwise.
@@ -51,7 +74,7 @@ constexpr auto WON_MESSAGE = " won!";
  * castling is executed: 'Q' for queenside, 'K' for kingside. assignment is only in case of
  * castling move.
  */
-void Game::_scanMove(string &src, string &dest, bool &isCastling, char &castlingSide) const
+void Game::_scanMove(Square &src, Square &dest, bool &isCastling, char &castlingSide) const
 {
     string move;
     std::cin >> move;
@@ -62,8 +85,8 @@ void Game::_scanMove(string &src, string &dest, bool &isCastling, char &castling
     }
     else
     {
-        src = move.substr (0, SQUARE_SIZE);
-        dest = move.substr (SQUARE_SIZE, SQUARE_SIZE * SQUARE_NUM);
+        src = parseSquare(move.substr (0, SQUARE_SIZE));
+        dest = parseSquare(move.substr (SQUARE_SIZE, SQUARE_SIZE * SQUARE_NUM));
         isCastling = false;
     }
 }
@@ -82,7 +105,7 @@ int Game::_runTurn(bool isCurrentInCheck)
     }
     std::cout << (_currentPlayer == WHITE ? _whitePlayerName: _blackPlayerName) << REQUEST_MOVE
               << std::endl;
-    string src, dest;
+    Square src, dest;
     bool isCastling;
     char castlingSide;
     _scanMove(src, dest, isCastling, castlingSide);
@@ -93,23 +116,55 @@ int Game::_runTurn(bool isCurrentInCheck)
     return _gameMaster.move(src, dest, _currentPlayer, isCurrentInCheck);
 }
 
+/**
+ * @brief lets the engine choose and execute the current player's next move, and prints it.
+ * @param isCurrentInCheck - true if the player moving is in check; false otherwise
+ */
+void Game::_runEngineTurn(bool isCurrentInCheck)
+{
+    _gameMaster.print();
+    if (isCurrentInCheck)
+    {
+        std::cout << CHECK_MESSAGE << std::endl;
+    }
+    SearchResult result = _gameMaster.engineMove(_engineLimits, std::cout, _engineThreadNum);
+    std::cout << ENGINE_NAME << ENGINE_MOVE_MESSAGE << moveName(result.bestMove) << std::endl;
+}
+
 /**
  * @brief runs a chess game.
  */
 void Game::run()
 {
-
-    std::cout << REQUEST_WHITE_PLAYER << std::endl;
-    std::getline(std::cin, _whitePlayerName);
-    std::cout << REQUEST_BLACK_PLAYER << std::endl;
-    std::getline(std::cin, _blackPlayerName);
+    if (_isEngine[colorIndex(WHITE)])
+    {
+        _whitePlayerName = ENGINE_NAME;
+    }
+    else
+    {
+        std::cout << REQUEST_WHITE_PLAYER << std::endl;
+        std::getline(std::cin, _whitePlayerName);
+    }
+    if (_isEngine[colorIndex(BLACK)])
+    {
+        _blackPlayerName = ENGINE_NAME;
+    }
+    else
+    {
+        std::cout << REQUEST_BLACK_PLAYER << std::endl;
+        std::getline(std::cin, _blackPlayerName);
+    }
 
     _currentPlayer = WHITE;
     bool isCurrentInCheck = false;
 
-    while(!_gameMaster.isInCheckmate(_currentPlayer, isCurrentInCheck))
+    while(_gameMaster.hasAnyLegalMove(_currentPlayer))
     {
-        while(!_runTurn(isCurrentInCheck))
+        if (_isEngine[colorIndex(_currentPlayer)])
+        {
+            _runEngineTurn(isCurrentInCheck);
+        }
+        while(!_isEngine[colorIndex(_currentPlayer)] && !_runTurn(isCurrentInCheck))
         {
             std::cout << ILLEGAL_MESSAGE << std::endl;
         }
@@ -117,6 +172,11 @@ void Game::run()
         isCurrentInCheck = _gameMaster.isInCheck(_currentPlayer);
     }
     _gameMaster.print();
+    if (!isCurrentInCheck)
+    {
+        std::cout << STALEMATE_MESSAGE << std::endl;
+        return;
+    }
     std::cout << (_currentPlayer == WHITE ? _blackPlayerName: _whitePlayerName) << WON_MESSAGE
               << std::endl;
 }
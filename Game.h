@@ -19,15 +19,19 @@ private:
     std::string _whitePlayerName; /** white player's name */
     std::string _blackPlayerName; /** black player's name */
     int _currentPlayer; /** color of current player: WHITE or BLACK */
+    bool _isEngine[COLOR_NUM]; /** true for a player played by the engine, by colorIndex() */
+    SearchLimits _engineLimits; /** the budget of every engine move */
+    int _engineThreadNum; /** number of threads searching every engine move */
 
     /**
      * @brief receives input from the user and parses it. input either represents a regular move on
      * the board, i.e. "A1B1", or a castling move: "o-o-o" or "o-o". assumes: legal format.
      * @param src - non-const ref, to which the function assigns: a square on the board, e.g.
-     * "A1", representing the position of the piece making the move. assignment is only in case
-     * of regular move.
+     * A1, representing the position of the piece making the move, or NO_SQUARE if the input isn't
+     * a square. assignment is only in case of regular move.
      * @param dest - non-const ref, to which the function assigns: a square on the board, e.g.
-     * "A1", representing the destination of the piece. assignment is only in case of regular move.
+     * A1, representing the destination of the piece, or NO_SQUARE if the input isn't a square.
+     * assignment is only in case of regular move.
      * making the move
      * @param isCastling - non-const ref, to which the function assigns: true if the given move
      * is a castling move; false otherwise.
@@ -35,7 +39,7 @@ private:
      * castling is executed: 'Q' for queenside, 'K' for kingside. assignment is only in case of
      * castling move.
      */
-    void _scanMove(string &src, string &dest, bool &isCastling, char &castlingSide) const;
+    void _scanMove(Square &src, Square &dest, bool &isCastling, char &castlingSide) const;
 
     /**
      * @brief runs the current player's next move.
@@ -44,8 +48,24 @@ private:
      */
     int _runTurn(bool isCurrentInCheck);
 
+    /**
+     * @brief lets the engine choose and execute the current player's next move, and prints it.
+     * @param isCurrentInCheck - true if the player moving is in check; false otherwise
+     */
+    void _runEngineTurn(bool isCurrentInCheck);
 
 public:
+    /**
+     * @brief a constructor for Game
+     * @param engineColor - color of the player played by the engine: WHITE or BLACK; 0 if both
+     * players are human
+     * @param engineLimits - the budget of every engine move
+     * @param tableMegabytes - size of the engine's transposition table, in megabytes
+     * @param engineThreadNum - number of threads searching every engine move
+     */
+    explicit Game(int engineColor = 0, const SearchLimits& engineLimits = SearchLimits(),
+                  size_t tableMegabytes = DEFAULT_TABLE_MEGABYTES, int engineThreadNum = 1);
+
     /**
      * @brief runs a chess game.
      */
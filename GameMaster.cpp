@@ -7,69 +7,51 @@
 
 // --------------------- const definitions ---------------------
 
-// max difference between ranks or files in a legal king's move
-constexpr int KING_RANGE = 1;
 // castling queenside: direction
 constexpr int Q_DIRECTION = -1;
 // castling kingside: direction
 constexpr int K_DIRECTION = 1;
-// castling queenside: rook dest
-constexpr int Q_ROOK = 3;
-// castling kingside: rook dest
-constexpr int K_ROOK = -2;
 
 
 // ------------------- class implementation --------------------
 
 /**
  * @brief receives path of squares on the board and checks whether they are all empty.
- * @param path - vector of squares on the board, representing a path
+ * @param path - bitboard of squares on the board, representing a path
  * @return true if all the squares in the path are empty; false otherwise.
  */
-bool GameMaster::_isEmptyPath(vector<string> *path) const
+bool GameMaster::_isEmptyPath(Bitboard path) const
 {
-    for (const auto& position: *path)
-    {
-        if (_board.getTempPiece(position) != nullptr)
-        {
-            return false;
-        }
-    }
-    return true;
+    return (path & _board.getOccupancy()) == EMPTY_BITBOARD;
 }
 
 /**
  * @brief checks whether the given move is pseudo-legal i.e. dest is in the piece's range and the
  * piece's path to dest is unhindered.
  * @param piece - the moving piece
- * @param dest - a square on the board, e.g. "A1", representing the destination of the piece
+ * @param dest - a square on the board, e.g. A1, representing the destination of the piece
  * making the move
  * @return true if the move is pseudo-legal; false otherwise.
  */
-bool GameMaster::_isPseudoPath(Piece *piece, const string &dest) const
+bool GameMaster::_isPseudoPath(Piece *piece, Square dest) const
 {
-    if (!_board.isInBoard(dest))
+    if (dest == NO_SQUARE)
     {
         return false;
     }
-    Piece* destPiece = _board.getTempPiece(dest);
-    bool isCapture = true;
-    if (destPiece == nullptr)
-    {
-        isCapture = false;
-    }
-    else if (destPiece->getColor() == piece->getColor())
+    int color = piece->getColor();
+    Bitboard destMask = squareMask(dest);
+    if (_board.getOccupancy(color) & destMask)
     {
         return false;
     }
+    bool isCapture = ((_board.getOccupancy(_reverseColor(color)) & destMask) != EMPTY_BITBOARD) ||
+                     _isEnPassant(piece, dest);
     if (!piece->canReach(dest, isCapture))
     {
         return false;
     }
-    vector<string>* path = piece->getPathTo(dest);
-    bool result = _isEmptyPath(path);
-    delete path;
-    return result;
+    return _isEmptyPath(piece->getPathMask(dest));
 }
 
 /**
@@ -79,84 +61,93 @@ bool GameMaster::_isPseudoPath(Piece *piece, const string &dest) const
  */
 bool GameMaster::isInCheck(int color)
 {
-    Piece* king = _board.getTempKing(color);
-    const string& kingPosition = king->getPosition();
-    vector<Piece*>& enemyPieces = _board.getTempPieces(_reverseColor(color));
-    for (const auto piece: enemyPieces)
-    {
-        if (_isPseudoPath(piece, kingPosition))
-        {
-            return true;
-        }
-    }
-    return false;
+    return _board.isInCheck(color);
 }
 
 /**
  * checks whether the given move constitutes a promotion i.e. the piece is src is a pawn and dest
  * is the edge of the board. assumes: move is pseudo-legal
- * @param src - a square on the board, e.g. "A1", representing the position of the piece making
+ * @param src - a square on the board, e.g. A1, representing the position of the piece making
  * the move
- * @param dest - a square on the board, e.g. "A1", representing the destination of the piece
+ * @param dest - a square on the board, e.g. A1, representing the destination of the piece
  * making the move
  * @return
  */
-bool GameMaster::_isPromotion(const string &src, const string &dest) const
+bool GameMaster::_isPromotion(Square src, Square dest) const
+{
+    Piece* srcPiece = _board.getPiece(src);
+    int endOfBoard = (srcPiece->getColor() == WHITE ? rankOf(H8): rankOf(A1));
+    return srcPiece->isPawn() && (rankOf(dest) == endOfBoard);
+}
+
+/**
+ * @brief checks whether the given move captures en passant i.e. the piece is a pawn and dest is
+ * the en passant square, which only a diagonal step can reach.
+ * @param piece - the piece making the move. assumes: piece isn't nullptr.
+ * @param dest - a square on the board, e.g. A1, representing the destination of the piece making
+ * the move
+ * @return true if the move captures en passant; false otherwise
+ */
+bool GameMaster::_isEnPassant(Piece *piece, Square dest) const
 {
-    Piece* srcPiece = _board.getTempPiece(src);
-    char endOfBoard = (srcPiece->getColor() == WHITE ? MAX_RANK: MIN_RANK);
-    return srcPiece->isPawn() && (dest[RANK_INDEX] == endOfBoard);
+    return piece->isPawn() && (dest == _board.getEnPassant()) &&
+           (fileOf(dest) != fileOf(piece->getPosition()));
 }
 
 /**
  * @brief executes a move in the game. if the move is illegal, it is not executed and the
  * function returns false.
- * @param src - a square on the board, e.g. "A1", representing the position of the piece making
- * the move
- * @param dest - a square on the board, e.g. "A1", representing the destination of the piece
- * making the move
+ * @param src - a square on the board, e.g. A1, representing the position of the piece making
+ * the move; NO_SQUARE if the player entered no valid square
+ * @param dest - a square on the board, e.g. A1, representing the destination of the piece
+ * making the move; NO_SQUARE if the player entered no valid square
  * @param currentPlayer - color of the player making the move: WHITE or BLACK
  * @param isCurrentInCheck - true if the player moving is in check; false otherwise
  * @return true if the move is legal (and has been executed); false otherwise
  */
 bool GameMaster::move
-        (const string& src, const string& dest, int currentPlayer, bool isCurrentInCheck)
+        (Square src, Square dest, int currentPlayer, bool isCurrentInCheck)
 {
-    if (!_board.isInBoard(src))
+    if (src == NO_SQUARE)
     {
         return false;
     }
-    Piece *srcPiece = _board.getTempPiece(src);
+    Piece *srcPiece = _board.getPiece(src);
     if ((srcPiece == nullptr) || (srcPiece->getColor() != currentPlayer))
     {
         return false;
     }
-    if (isCurrentInCheck && !srcPiece->isKing())
+    if (!_isPseudoPath(srcPiece, dest))
     {
         return false;
     }
-    if (!_isPseudoPath(srcPiece, dest))
+    int flags = (_board.getPiece(dest) != nullptr ? CAPTURE: QUIET_MOVE);
+    if (_isPromotion(src, dest))
     {
-        return false;
+        flags |= promotionFlags(QUEEN);
     }
-    bool promotion = _isPromotion(src, dest);
-    _board.tempMove(src, dest);
-    if (isInCheck(srcPiece->getColor()))
+    else if (srcPiece->isPawn() && (abs(rankOf(dest) - rankOf(src)) == 2))
     {
-        _board.undoMoves();
-        return false;
+        flags = DOUBLE_PAWN_PUSH;
     }
-    if (promotion)
+    else if (_isEnPassant(srcPiece, dest))
     {
-        _board.tempPromote(srcPiece);
+        flags = EN_PASSANT;
     }
+    Move move(src, dest, flags);
+    Bitboard checkers = (isCurrentInCheck ? _board.getCheckers(currentPlayer): EMPTY_BITBOARD);
+    if (!_board.isLegal(move, checkers, _board.getPinned(currentPlayer)))
+    {
+        return false;
+    }
+    _board.makeMove(move);
     _board.saveMoves();
     return true;
 }
 
 /**
- * @brief checks whether the given castling move is pseudo-legal i.e. neither the king and rook
- * involved in the move have never moved and the path between them is empty.
+ * @brief checks whether the given castling move is pseudo-legal i.e. the player still has the
+ * castling right to that side and the path between the king and rook is empty.
  * @param castlingSide  - side to which the castling is executed: 'Q' for queenside, 'K' for
  * kingside
  * @param currentPlayer - color of player performing the castling: WHITE or BLACK
@@ -167,28 +158,18 @@ bool GameMaster::move
  * @return true if the castling move is pseduo-legal; false otherwise.
  */
 bool GameMaster::_isPseudoLegalCastling
-        (char castlingSide, int currentPlayer, string &kingSrc, string &rookSrc) const
+        (char castlingSide, int currentPlayer, Square &kingSrc, Square &rookSrc) const
 {
-    Piece* king = _board.getTempKing(currentPlayer);
-    if (king->hasMoved())
+    if (!_board.canCastle(currentPlayer, castlingSide == KINGSIDE))
     {
         return false;
     }
-    kingSrc = king->getPosition();
-
-    char rookSrcFile = (castlingSide == QUEENSIDE ? MIN_FILE: MAX_FILE);
-    rookSrc = string(1, rookSrcFile) + string(1, kingSrc[RANK_INDEX]);
+    kingSrc = _board.getKing(currentPlayer)->getPosition();
 
-    Piece* rook = _board.getTempPiece(rookSrc);
-    if ((rook == nullptr) || (rook->hasMoved()))
-    {
-        return false;
-    }
+    int rookSrcFile = (castlingSide == QUEENSIDE ? fileOf(A1): fileOf(H1));
+    rookSrc = makeSquare(rookSrcFile, rankOf(kingSrc));
 
-    vector<string>* rookToKingPath = rook->getPathTo(kingSrc);
-    bool result = _isEmptyPath(rookToKingPath);
-    delete rookToKingPath;
-    return result;
+    return _isEmptyPath(_board.getPiece(rookSrc)->getPathMask(kingSrc));
 }
 
 /**
@@ -202,59 +183,55 @@ bool GameMaster::_isPseudoLegalCastling
  */
 bool GameMaster::castling(char castlingSide, int currentPlayer, bool isCurrentInCheck)
 {
-    string kingSrc, rookSrc;
+    Square kingSrc, rookSrc;
     if (!_isPseudoLegalCastling(castlingSide, currentPlayer, kingSrc, rookSrc))
     {
         return false;
     }
 
     int direction = (castlingSide == QUEENSIDE ? Q_DIRECTION: K_DIRECTION);
-    auto kingMidFile = char(kingSrc[FILE_INDEX] + direction);
-    auto kingDestFile = char(kingMidFile + direction);
-    const string& kingMid = string(1, kingMidFile) + string(1, kingSrc[RANK_INDEX]);
-    const string& kingDest = string(1, kingDestFile) + string(1, kingSrc[RANK_INDEX]);
+    auto kingMid = Square(kingSrc + direction);
+    auto kingDest = Square(kingMid + direction);
 
-    bool result = isCurrentInCheck;
-    _board.tempMove(kingSrc, kingMid);
-    result = result || isInCheck(currentPlayer);
-    _board.tempMove(kingMid, kingDest);
-    result = result || isInCheck(currentPlayer);
-    if (result)
+    // the rook lands between the king's source and destination, blocking any ray the king opens,
+    // so the destination is attacked after castling if and only if it's attacked now
+    int opponent = _reverseColor(currentPlayer);
+    if (isCurrentInCheck || _board.isAttacked(kingMid, opponent) ||
+        _board.isAttacked(kingDest, opponent))
     {
-        _board.undoMoves();
         return false;
     }
 
-    auto rookDestFile = char(rookSrc[FILE_INDEX] + (castlingSide == QUEENSIDE ? Q_ROOK: K_ROOK));
-    const string& rookDest = string(1, rookDestFile) + string(1, kingSrc[RANK_INDEX]);
-    _board.tempMove(rookSrc, rookDest);
+    int flags = (castlingSide == QUEENSIDE ? QUEEN_CASTLE: KING_CASTLE);
+    _board.makeMove(Move(kingSrc, kingDest, flags));
     _board.saveMoves();
     return true;
 }
 
 /**
- * @brief gets all moves in the given king's range i.e. one square in every direction.
- * allocates memory in freestore.
- * @param kingsPosition - a square on the board, e.g. "A1", representing the given king's
- * position
- * @return vector of squares on the board representing every move in the given king's range
+ * @brief searches the best move of the player to move within the given limits, and executes it.
+ * assumes: the player to move has a legal move.
+ * @param limits - the budget of the search
+ * @param out - stream to which every iteration of the search is reported
+ * @param threadNum - number of threads searching in parallel
+ * @return the result of the search, whose best move has been executed
  */
-vector<string>* GameMaster::_getKingMoves(const string &kingsPosition) const
+SearchResult GameMaster::engineMove(const SearchLimits& limits, std::ostream& out, int threadNum)
 {
-    char positionFile = kingsPosition[FILE_INDEX];
-    char positionRank = kingsPosition[RANK_INDEX];
-    string newPosition;
+    SearchResult result = bestMove(_board, limits, _table, out, threadNum);
+    _board.makeMove(result.bestMove);
+    _board.saveMoves();
+    return result;
+}
 
-    auto* newMoves = new vector<string>;
-    for (int i = -1; i <= 1; i++)
-    {
-        for (int j = -1; j <= 1; j++)
-        {
-            newPosition = string(1, char(positionFile + i)) + string(1, char(positionRank + j));
-            newMoves->push_back(newPosition);
-        }
-    }
-    return newMoves;
+/**
+ * @brief checks whether the given player has a legal move, stopping at the first one found.
+ * @param color - player color: WHITE or BLACK
+ * @return true if the given player has a legal move; false if it's checkmated or stalemated
+ */
+bool GameMaster::hasAnyLegalMove(int color) const
+{
+    return hasLegalMove(_board, color);
 }
 
 /**
@@ -265,30 +242,5 @@ vector<string>* GameMaster::_getKingMoves(const string &kingsPosition) const
  */
 bool GameMaster::isInCheckmate(int color, bool isColorInCheck)
 {
-    if (!isColorInCheck)
-    {
-        return false;
-    }
-    Piece* king = _board.getTempKing(color);
-    string kingsPosition = king->getPosition();
-    vector<string>* kingMoves = _getKingMoves(kingsPosition);
-    bool result;
-    for (const auto& dest: *kingMoves)
-    {
-        // board getters must be reset after undoMoves(), saveMoves()
-        king = _board.getTempKing(color);
-        if (_isPseudoPath(king, dest))
-        {
-            _board.tempMove(kingsPosition, dest);
-            result = isInCheck(color);
-            _board.undoMoves();
-            if (!result)
-            {
-                delete kingMoves;
-                return false;
-            }
-        }
-    }
-    delete kingMoves;
-    return true;
+    return isColorInCheck && !hasAnyLegalMove(color);
 }
\ No newline at end of file
@@ -5,12 +5,10 @@
 
 // ------------------------- includes --------------------------
 
-#include "Board.h"
+#include "Search.h"
 
 // --------------------- const definitions ---------------------
 
-// reverse color
-constexpr int REVERSE = -1;
 // castling queenside indicator
 constexpr auto QUEENSIDE = 'Q';
 // castling kingside indicator
@@ -25,6 +23,7 @@ class GameMaster
 {
 private:
     Board _board; /** chess Board */
+    TranspositionTable _table; /** the engine's transposition table, kept between its moves */
 
     /**
      * @brief returns the reverse of the given color i.e. WHITE for BLACK and vice versa.
@@ -35,35 +34,45 @@ private:
 
     /**
      * @brief receives path of squares on the board and checks whether they are all empty.
-     * @param path - vector of squares on the board, representing a path
+     * @param path - bitboard of squares on the board, representing a path
      * @return true if all the squares in the path are empty; false otherwise.
      */
-    bool _isEmptyPath(vector<string> *path) const;
+    bool _isEmptyPath(Bitboard path) const;
 
     /**
      * @brief checks whether the given move is pseudo-legal i.e. dest is in the piece's range and
      * the piece's path to dest is unhindered.
      * @param piece - the moving piece
-     * @param dest - a square on the board, e.g. "A1", representing the destination of the piece
+     * @param dest - a square on the board, e.g. A1, representing the destination of the piece
      * making the move
      * @return true if the move is pseudo-legal; false otherwise.
      */
-    bool _isPseudoPath(Piece *piece, const string &dest) const;
+    bool _isPseudoPath(Piece *piece, Square dest) const;
 
     /**
      * checks whether the given move constitutes a promotion i.e. the piece is src is a pawn and
      * dest is the edge of the board.  assumes: move is pseudo-legal
-     * @param src - a square on the board, e.g. "A1", representing the position of the piece making
+     * @param src - a square on the board, e.g. A1, representing the position of the piece making
      * the move
-     * @param dest - a square on the board, e.g. "A1", representing the destination of the piece
+     * @param dest - a square on the board, e.g. A1, representing the destination of the piece
      * making the move
      * @return
      */
-    bool _isPromotion(const string &src, const string &dest) const;
+    bool _isPromotion(Square src, Square dest) const;
 
     /**
-     * @brief checks whether the given castling move is pseudo-legal i.e. neither the king and rook
-     * involved in the move have never moved and the path between them is empty.
+     * @brief checks whether the given move captures en passant i.e. the piece is a pawn and dest
+     * is the en passant square, which only a diagonal step can reach.
+     * @param piece - the piece making the move. assumes: piece isn't nullptr.
+     * @param dest - a square on the board, e.g. A1, representing the destination of the piece
+     * making the move
+     * @return true if the move captures en passant; false otherwise
+     */
+    bool _isEnPassant(Piece *piece, Square dest) const;
+
+    /**
+     * @brief checks whether the given castling move is pseudo-legal i.e. the player still has the
+     * castling right to that side and the path between the king and rook is empty.
      * @param castlingSide  - side to which the castling is executed: 'Q' for queenside, 'K' for
      * kingside
      * @param currentPlayer - color of player performing the castling: WHITE or BLACK
@@ -74,18 +83,16 @@ private:
      * @return true if the castling move is pseduo-legal; false otherwise.
      */
     bool _isPseudoLegalCastling
-            (char castlingSide, int currentPlayer, string &kingSrc, string &rookSrc) const;
+            (char castlingSide, int currentPlayer, Square &kingSrc, Square &rookSrc) const;
 
+public:
     /**
-     * @brief gets all moves in the given king's range i.e. one square in every direction.
-     * allocates memory in freestore.
-     * @param kingsPosition - a square on the board, e.g. "A1", representing the given king's
-     * position
-     * @return vector of squares on the board representing every move in the given king's range
+     * @brief a constructor for GameMaster. the board is in the initial position.
+     * @param tableMegabytes - size of the engine's transposition table, in megabytes
      */
-    vector<string>* _getKingMoves(const string &kingsPosition) const;
+    explicit GameMaster(size_t tableMegabytes = DEFAULT_TABLE_MEGABYTES):
+            _table(tableMegabytes) {}
 
-public:
     /**
      * @brief checks whether the given player is in check
      * @param color - color of the given player: WHITE or BLACK
@@ -96,15 +103,15 @@ public:
     /**
      * @brief executes a move in the game. if the move is illegal, it is not executed and the
      * function returns false.
-     * @param src - a square on the board, e.g. "A1", representing the position of the piece making
-     * the move
-     * @param dest - a square on the board, e.g. "A1", representing the destination of the piece
-     * making the move
+     * @param src - a square on the board, e.g. A1, representing the position of the piece making
+     * the move; NO_SQUARE if the player entered no valid square
+     * @param dest - a square on the board, e.g. A1, representing the destination of the piece
+     * making the move; NO_SQUARE if the player entered no valid square
      * @param currentPlayer - color of the player making the move: WHITE or BLACK
      * @param isCurrentInCheck - true if the player moving is in check; false otherwise
      * @return true if the move is legal (and has been executed); false otherwise
      */
-    bool move(const string& src, const string& dest, int currentPlayer, bool isCurrentInCheck);
+    bool move(Square src, Square dest, int currentPlayer, bool isCurrentInCheck);
 
     /**
      * @brief executes a castling move in the game. if the castling is illegal, it is not
@@ -117,6 +124,23 @@ public:
      */
     bool castling(char castlingSide, int currentPlayer, bool isCurrentInCheck);
 
+    /**
+     * @brief searches the best move of the player to move within the given limits, and executes
+     * it. assumes: the player to move has a legal move.
+     * @param limits - the budget of the search
+     * @param out - stream to which every iteration of the search is reported
+     * @param threadNum - number of threads searching in parallel
+     * @return the result of the search, whose best move has been executed
+     */
+    SearchResult engineMove(const SearchLimits& limits, std::ostream& out, int threadNum);
+
+    /**
+     * @brief checks whether the given player has a legal move, stopping at the first one found.
+     * @param color - player color: WHITE or BLACK
+     * @return true if the given player has a legal move; false if it's checkmated or stalemated
+     */
+    bool hasAnyLegalMove(int color) const;
+
     /**
      * @brief check whether the given player is in checkmate
      * @param color - player color: WHITE or BLACK
@@ -128,7 +152,7 @@ public:
     /**
      * @brief prints the board.
      */
-    void print() {_board.tempPrint(); }
+    void print() {_board.print(); }
 };
 
 #endif //CHESS_CPP_GAMEMASTER_H
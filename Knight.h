@@ -5,7 +5,7 @@
 
 // ------------------------- includes --------------------------
 
-#include "Piece.h"
+#include "Bitboard.h"
 
 // --------------------- const definitions ---------------------
 
@@ -15,7 +15,8 @@ constexpr auto KNIGHT_UNICODE = "\u265E";
 // --------------------- class declaration ---------------------
 
 /**
- * This class represents a knight in chess game. extends the class Piece.
+ * This class represents a knight in chess game. extends the class Piece, which dispatches to
+ * the knight's static movement rules by its type.
  */
 class Knight: public Piece
 {
@@ -23,50 +24,21 @@ public:
     /**
      * @brief a constructor for Knight
      * @param color - color of Knight: WHITE or BLACK
-     * @param position - initial position of Knight on the board, e.g. "A1"
+     * @param position - initial position of Knight on the board, e.g. A1
      */
-    Knight(int color, const string& position): Piece(color, position, true) {}
+    Knight(int color, Square position): Piece(color, position, true, KNIGHT) {}
 
     /**
-     * @brief creates a deep copy of Knight. allocates memory in freestore.
-     * @return new clone of Knight
+     * @brief checks whether dest is in a knight's range of movement, i.e. two squares vertically
+     * and one square horizontally, or two squares horizontally and one square vertically
+     * @param position - the knight's square
+     * @param dest - a square on the board, e.g. A1
+     * @return true if dest is in the knight's range of movement, false otherwise
      */
-    Knight* clone() override {return new Knight(*this); }
-
-    /**
-     * @brief checks whether dest is in Knight's range of movement, i.e. two squares vertically and
-     * one square horizontally, or two squares horizontally and one square vertically
-     * @param dest - a square on the board, e.g. "A1"
-     * @return true if dest is in Knight's range of movement, false otherwise
-     */
-    bool canReach(const string& dest, bool) const override;
-
-    /**
-     * @brief generates an empty vector, representing a path between Knight's position and dest,
-     * excluding position and dest. (empty because Knight skips over squares when it moves).
-     * assumes: Knight.canReach(dest) = true. allocates memory in freestore.
-     * @param dest - a square on the board, e.g. "A1"
-     * @return a empty vector of squares on the board, representing a path between Knight and dest.
-     */
-    vector<string>* getPathTo(const string&) const override {return new vector<string>; }
-
-    /**
-     * @brief returns the unicode character which prints Knight
-     * @return the unicode character for the chess knight
-     */
-    string print() const override {return KNIGHT_UNICODE; }
-
-    /**
-     * @brief checks whether this piece is a king
-     * return false
-     */
-    bool isKing() const override {return false; }
-
-    /**
-     * @brief checks whether this piece is a pawn
-     * return false
-     */
-    bool isPawn() const override {return false; }
+    static bool reaches(int, Square position, Square dest, bool)
+    {
+        return (knightAttacks(position) & squareMask(dest)) != EMPTY_BITBOARD;
+    }
 };
 
 #endif //CHESS_CPP_KNIGHT_H
\ No newline at end of file
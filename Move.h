@@ -0,0 +1,176 @@
+// Move.h
+
+#ifndef CHESS_CPP_MOVE_H
+#define CHESS_CPP_MOVE_H
+
+// ------------------------- includes --------------------------
+
+#include <cstdint>
+#include "Piece.h"
+
+// --------------------- const definitions ---------------------
+
+// move flag: a move to an empty square
+constexpr int QUIET_MOVE = 0;
+// move flag: a pawn moving two squares forward
+constexpr int DOUBLE_PAWN_PUSH = 1;
+// move flag: castling kingside
+constexpr int KING_CASTLE = 2;
+// move flag: castling queenside
+constexpr int QUEEN_CASTLE = 3;
+// move flag bit: the move captures a piece
+constexpr int CAPTURE = 4;
+// move flag: a pawn capturing en passant
+constexpr int EN_PASSANT = CAPTURE | 1;
+// move flag bit: the move promotes a pawn. the two low flag bits hold the promotion type
+constexpr int PROMOTION = 8;
+
+// number of bits holding a square in a packed move
+constexpr int MOVE_SQUARE_BITS = 6;
+// mask of a square in a packed move
+constexpr int MOVE_SQUARE_MASK = (1 << MOVE_SQUARE_BITS) - 1;
+// mask of the promotion type in a move's flags
+constexpr int PROMOTION_TYPE_MASK = 3;
+
+// --------------------- class declaration ---------------------
+
+/**
+ * This class represents a move on the board, packed into 16 bits: bits 0-5 hold the source square,
+ * bits 6-11 the destination square and bits 12-15 the move's flags.
+ */
+class Move
+{
+private:
+    uint16_t _data; /** the packed move */
+
+public:
+    /**
+     * @brief a constructor for an empty (null) Move
+     */
+    constexpr Move(): _data(0) {}
+
+    /**
+     * @brief a constructor for Move
+     * @param src - square of the piece making the move
+     * @param dest - destination square of the move
+     * @param flags - flags of the move, e.g. CAPTURE
+     */
+    constexpr Move(Square src, Square dest, int flags = QUIET_MOVE):
+            _data(uint16_t(src | (dest << MOVE_SQUARE_BITS) | (flags << (2 * MOVE_SQUARE_BITS)))) {}
+
+    /**
+     * @brief returns the Move packed in the given data, e.g. as stored in a transposition table
+     * @param data - the packed move, as returned by getData()
+     * @return the move
+     */
+    static constexpr Move fromData(uint16_t data)
+    {
+        Move move;
+        move._data = data;
+        return move;
+    }
+
+    /**
+     * @brief returns the packed Move
+     * @return source, destination and flags of Move, packed in 16 bits
+     */
+    constexpr uint16_t getData() const {return _data; }
+
+    /**
+     * @brief returns the source square of Move
+     * @return square of the piece making the move
+     */
+    constexpr Square getSrc() const {return Square(_data & MOVE_SQUARE_MASK); }
+
+    /**
+     * @brief returns the destination square of Move
+     * @return destination square of the move
+     */
+    constexpr Square getDest() const
+    {
+        return Square((_data >> MOVE_SQUARE_BITS) & MOVE_SQUARE_MASK);
+    }
+
+    /**
+     * @brief returns the flags of Move
+     * @return flags of the move, e.g. CAPTURE
+     */
+    constexpr int getFlags() const {return _data >> (2 * MOVE_SQUARE_BITS); }
+
+    /**
+     * @brief checks whether Move captures a piece
+     * @return true if Move is a capture; false otherwise
+     */
+    constexpr bool isCapture() const {return (getFlags() & CAPTURE) != 0; }
+
+    /**
+     * @brief checks whether Move promotes a pawn
+     * @return true if Move is a promotion; false otherwise
+     */
+    constexpr bool isPromotion() const {return (getFlags() & PROMOTION) != 0; }
+
+    /**
+     * @brief checks whether Move is a castling move
+     * @return true if Move is a castling move; false otherwise
+     */
+    constexpr bool isCastling() const
+    {
+        return (getFlags() == KING_CASTLE) || (getFlags() == QUEEN_CASTLE);
+    }
+
+    /**
+     * @brief returns the type of the piece a pawn is promoted to. assumes: Move is a promotion.
+     * @return KNIGHT, BISHOP, ROOK or QUEEN
+     */
+    constexpr PieceType getPromotionType() const
+    {
+        return PieceType(KNIGHT + (getFlags() & PROMOTION_TYPE_MASK));
+    }
+
+    /**
+     * @brief checks whether Move is the empty (null) move
+     * @return true if Move is empty; false otherwise
+     */
+    constexpr bool isNull() const {return _data == 0; }
+
+    /**
+     * @brief compares two moves
+     * @param other - other Move
+     * @return true if both moves are equal; false otherwise
+     */
+    constexpr bool operator==(const Move& other) const {return _data == other._data; }
+
+    /**
+     * @brief compares two moves
+     * @param other - other Move
+     * @return true if the moves differ; false otherwise
+     */
+    constexpr bool operator!=(const Move& other) const {return _data != other._data; }
+};
+
+// ------------------- function declarations -------------------
+
+/**
+ * @brief returns the move flags of a promotion to the given piece type
+ * @param type - KNIGHT, BISHOP, ROOK or QUEEN
+ * @return flags of the promotion, without the CAPTURE bit
+ */
+constexpr int promotionFlags(PieceType type) {return PROMOTION | (type - KNIGHT); }
+
+/**
+ * @brief returns the name of a move in the format the game reads, e.g. E2E4, followed by the
+ * letter of the promotion type for a promotion, e.g. E7E8q
+ * @param move - a move
+ * @return name of the move
+ */
+inline string moveName(Move move)
+{
+    string name = squareName(move.getSrc()) + squareName(move.getDest());
+    if (move.isPromotion())
+    {
+        name += PIECE_LETTERS[move.getPromotionType()];
+    }
+    return name;
+}
+
+#endif //CHESS_CPP_MOVE_H
\ No newline at end of file
@@ -0,0 +1,287 @@
+// MoveGen.cpp
+// This file contains the implementation of the move generator
+
+// ------------------------- includes --------------------------
+
+#include "MoveGen.h"
+
+// --------------------- const definitions ---------------------
+
+// rank on which white pawns are promoted
+constexpr int WHITE_PROMOTION_RANK = BOARD_SIZE - 1;
+// rank on which black pawns are promoted
+constexpr int BLACK_PROMOTION_RANK = 0;
+// piece types a pawn can be promoted to
+constexpr PieceType PROMOTION_TYPES[] = {QUEEN, ROOK, BISHOP, KNIGHT};
+
+// ----------------- function implementation -------------------
+
+/**
+ * @brief appends a pawn move, expanded to all four promotions if the pawn reaches the last rank
+ * @param src - the pawn's square
+ * @param dest - destination square of the move
+ * @param flags - flags of the move, without the promotion bits
+ * @param color - color of the pawn: WHITE or BLACK
+ * @param moves - non-const ref, to which the function appends the move
+ */
+static void _addPawnMove(Square src, Square dest, int flags, int color, MoveList& moves)
+{
+    int promotionRank = (color == WHITE ? WHITE_PROMOTION_RANK: BLACK_PROMOTION_RANK);
+    if (rankOf(dest) != promotionRank)
+    {
+        moves.add(Move(src, dest, flags));
+        return;
+    }
+    for (PieceType type: PROMOTION_TYPES)
+    {
+        moves.add(Move(src, dest, flags | promotionFlags(type)));
+    }
+}
+
+/**
+ * @brief appends the selected pseudo-legal moves of the given player's pawns
+ * @param board - the position
+ * @param color - color of the player: WHITE or BLACK
+ * @param selection - NOISY_MOVES, QUIET_MOVES or ALL_MOVES
+ * @param moves - non-const ref, to which the function appends the moves
+ */
+static void _generatePawnMoves(const Board& board, int color, int selection, MoveList& moves)
+{
+    Bitboard occupied = board.getOccupancy();
+    Bitboard enemies = board.getOccupancy(color * REVERSE);
+    Square enPassant = board.getEnPassant();
+    int startRank = (color == WHITE ? WHITE_PAWN_RANK: BLACK_PAWN_RANK);
+    int promotionRank = (color == WHITE ? WHITE_PROMOTION_RANK: BLACK_PROMOTION_RANK);
+    int forward = BOARD_SIZE * color;
+
+    Bitboard pawns = board.getPieces(color, PAWN);
+    while (pawns)
+    {
+        Square src = popLsb(pawns);
+        auto dest = Square(src + forward);
+        // a push is noisy if it promotes
+        int pushSelection = (rankOf(dest) == promotionRank ? NOISY_MOVES: QUIET_MOVES);
+        if ((selection & pushSelection) && !(occupied & squareMask(dest)))
+        {
+            _addPawnMove(src, dest, QUIET_MOVE, color, moves);
+            auto doubleDest = Square(dest + forward);
+            if ((rankOf(src) == startRank) && !(occupied & squareMask(doubleDest)))
+            {
+                moves.add(Move(src, doubleDest, DOUBLE_PAWN_PUSH));
+            }
+        }
+        if (!(selection & NOISY_MOVES))
+        {
+            continue;
+        }
+        Bitboard attacks = pawnAttacks(color, src);
+        Bitboard captures = attacks & enemies;
+        while (captures)
+        {
+            _addPawnMove(src, popLsb(captures), CAPTURE, color, moves);
+        }
+        if ((enPassant != NO_SQUARE) && (attacks & squareMask(enPassant)))
+        {
+            moves.add(Move(src, enPassant, EN_PASSANT));
+        }
+    }
+}
+
+/**
+ * @brief appends the selected pseudo-legal moves of the given player's pieces of the given type,
+ * except castling
+ * @param board - the position
+ * @param color - color of the player: WHITE or BLACK
+ * @param type - KNIGHT, BISHOP, ROOK, QUEEN or KING
+ * @param selection - NOISY_MOVES, QUIET_MOVES or ALL_MOVES
+ * @param moves - non-const ref, to which the function appends the moves
+ */
+static void _generatePieceMoves(const Board& board, int color, PieceType type, int selection,
+                                MoveList& moves)
+{
+    Bitboard occupied = board.getOccupancy();
+    Bitboard enemies = board.getOccupancy(color * REVERSE);
+    Bitboard targets = ((selection & NOISY_MOVES) ? enemies: EMPTY_BITBOARD) |
+                       ((selection & QUIET_MOVES) ? ~occupied: EMPTY_BITBOARD);
+
+    Bitboard pieces = board.getPieces(color, type);
+    while (pieces)
+    {
+        Square src = popLsb(pieces);
+        Bitboard attacks = pieceAttacks(type, color, src, occupied) & targets;
+        while (attacks)
+        {
+            Square dest = popLsb(attacks);
+            moves.add(Move(src, dest, (enemies & squareMask(dest) ? CAPTURE: QUIET_MOVE)));
+        }
+    }
+}
+
+/**
+ * @brief appends the given player's castling moves whose castling right is available, whose
+ * path between king and rook is empty, and whose king neither is in check nor passes through an
+ * attacked square. the king's destination is checked by the legality test.
+ * @param board - the position
+ * @param color - color of the player: WHITE or BLACK
+ * @param moves - non-const ref, to which the function appends the moves
+ */
+static void _generateCastlingMoves(const Board& board, int color, MoveList& moves)
+{
+    if (!board.canCastle(color, true) && !board.canCastle(color, false))
+    {
+        return;
+    }
+    Square kingSrc = lsb(board.getPieces(color, KING));
+    if (board.isAttacked(kingSrc, color * REVERSE))
+    {
+        return;
+    }
+    Bitboard occupied = board.getOccupancy();
+    for (bool kingside: {true, false})
+    {
+        int rookFile = (kingside ? KINGSIDE_ROOK_FILE: QUEENSIDE_ROOK_FILE);
+        Square rookSrc = makeSquare(rookFile, rankOf(kingSrc));
+        int direction = (kingside ? 1: -1);
+        auto kingMid = Square(kingSrc + direction);
+        if (!board.canCastle(color, kingside) || (betweenMask(kingSrc, rookSrc) & occupied) ||
+            board.isAttacked(kingMid, color * REVERSE))
+        {
+            continue;
+        }
+        int flags = (kingside ? KING_CASTLE: QUEEN_CASTLE);
+        moves.add(Move(kingSrc, Square(kingMid + direction), flags));
+    }
+}
+
+/**
+ * @brief generates the selected pseudo-legal moves of the player to move, i.e. moves that follow
+ * the pieces' movement rules but may leave that player's king in check. castling moves are only
+ * generated if the king is not in check and doesn't pass through an attacked square.
+ * @param board - the position
+ * @param moves - non-const ref, to which the function appends the generated moves
+ * @param selection - NOISY_MOVES, QUIET_MOVES or ALL_MOVES
+ */
+void generatePseudoLegalMoves(const Board& board, MoveList& moves, int selection)
+{
+    int color = board.getSideToMove();
+    _generatePawnMoves(board, color, selection, moves);
+    for (PieceType type: {KNIGHT, BISHOP, ROOK, QUEEN, KING})
+    {
+        _generatePieceMoves(board, color, type, selection, moves);
+    }
+    if (selection & QUIET_MOVES)
+    {
+        _generateCastlingMoves(board, color, moves);
+    }
+}
+
+/**
+ * @brief checks whether a move is pseudo-legal for the player to move, e.g. a move read from the
+ * transposition table, which may belong to another position. only the moves of the moving piece's
+ * type are generated.
+ * @param board - the position
+ * @param move - the move
+ * @return true if move is pseudo-legal; false otherwise
+ */
+bool isPseudoLegal(const Board& board, Move move)
+{
+    int color = board.getSideToMove();
+    Piece* piece = board.getPiece(move.getSrc());
+    if (move.isNull() || (piece == nullptr) || (piece->getColor() != color))
+    {
+        return false;
+    }
+    MoveList moves;
+    if (piece->isPawn())
+    {
+        _generatePawnMoves(board, color, ALL_MOVES, moves);
+    }
+    else
+    {
+        _generatePieceMoves(board, color, piece->getType(), ALL_MOVES, moves);
+    }
+    if (piece->isKing())
+    {
+        _generateCastlingMoves(board, color, moves);
+    }
+    return std::find(moves.begin(), moves.end(), move) != moves.end();
+}
+
+/**
+ * @brief generates all legal moves of the player to move, including promotions, castling, en
+ * passant and every evasion of a check. legality is decided from the checkers and pinned pieces of
+ * the position, without making the moves.
+ * @param board - the position
+ * @param moves - non-const ref, to which the function appends the generated moves
+ */
+void generateLegalMoves(const Board& board, MoveList& moves)
+{
+    int color = board.getSideToMove();
+    Bitboard checkers = board.getCheckers(color), pinned = board.getPinned(color);
+    MoveList pseudoLegal;
+    generatePseudoLegalMoves(board, pseudoLegal);
+    for (Move move: pseudoLegal)
+    {
+        if (board.isLegal(move, checkers, pinned))
+        {
+            moves.add(move);
+        }
+    }
+}
+
+/**
+ * @brief checks whether any of the given moves is legal
+ * @param board - the position
+ * @param moves - pseudo-legal moves of one player
+ * @param checkers - getCheckers() of that player
+ * @param pinned - getPinned() of that player
+ * @return true if a move is legal; false otherwise
+ */
+static bool _containsLegalMove(const Board& board, const MoveList& moves, Bitboard checkers,
+                               Bitboard pinned)
+{
+    for (Move move: moves)
+    {
+        if (board.isLegal(move, checkers, pinned))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief checks whether the given player has a legal move, i.e. is neither checkmated nor
+ * stalemated. stops at the first piece type with a legal move, trying the king first: its moves
+ * are few, cheap to test and the only ones in double check. castling is never needed, as a legal
+ * castling implies a legal king step.
+ * @param board - the position
+ * @param color - color of the player: WHITE or BLACK
+ * @return true if color has a legal move; false otherwise
+ */
+bool hasLegalMove(const Board& board, int color)
+{
+    Bitboard checkers = board.getCheckers(color), pinned = board.getPinned(color);
+    MoveList moves;
+    _generatePieceMoves(board, color, KING, ALL_MOVES, moves);
+    if (_containsLegalMove(board, moves, checkers, pinned))
+    {
+        return true;
+    }
+    if (popCount(checkers) > 1)
+    {
+        return false;
+    }
+    for (PieceType type: {KNIGHT, BISHOP, ROOK, QUEEN})
+    {
+        moves.clear();
+        _generatePieceMoves(board, color, type, ALL_MOVES, moves);
+        if (_containsLegalMove(board, moves, checkers, pinned))
+        {
+            return true;
+        }
+    }
+    moves.clear();
+    _generatePawnMoves(board, color, ALL_MOVES, moves);
+    return _containsLegalMove(board, moves, checkers, pinned);
+}
\ No newline at end of file
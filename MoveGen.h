@@ -0,0 +1,62 @@
+// MoveGen.h
+
+#ifndef CHESS_CPP_MOVEGEN_H
+#define CHESS_CPP_MOVEGEN_H
+
+// ------------------------- includes --------------------------
+
+#include "Board.h"
+#include "MoveList.h"
+
+// --------------------- const definitions ---------------------
+
+/**
+ * the kinds of moves a generator is asked for
+ */
+enum MoveSelection
+{
+    NOISY_MOVES = 1, /** captures, en passant captures and promotions */
+    QUIET_MOVES = 2, /** all other moves, including castling */
+    ALL_MOVES = NOISY_MOVES | QUIET_MOVES /** all moves */
+};
+
+// ------------------- function declarations -------------------
+
+/**
+ * @brief generates the selected pseudo-legal moves of the player to move, i.e. moves that follow
+ * the pieces' movement rules but may leave that player's king in check. castling moves are only
+ * generated if the king is not in check and doesn't pass through an attacked square.
+ * @param board - the position
+ * @param moves - non-const ref, to which the function appends the generated moves
+ * @param selection - NOISY_MOVES, QUIET_MOVES or ALL_MOVES
+ */
+void generatePseudoLegalMoves(const Board& board, MoveList& moves, int selection = ALL_MOVES);
+
+/**
+ * @brief checks whether a move is pseudo-legal for the player to move, e.g. a move read from the
+ * transposition table, which may belong to another position.
+ * @param board - the position
+ * @param move - the move
+ * @return true if move is pseudo-legal; false otherwise
+ */
+bool isPseudoLegal(const Board& board, Move move);
+
+/**
+ * @brief generates all legal moves of the player to move, including promotions, castling, en
+ * passant and every evasion of a check. legality is decided from the checkers and pinned pieces of
+ * the position, without making the moves.
+ * @param board - the position
+ * @param moves - non-const ref, to which the function appends the generated moves
+ */
+void generateLegalMoves(const Board& board, MoveList& moves);
+
+/**
+ * @brief checks whether the given player has a legal move, i.e. is neither checkmated nor
+ * stalemated. stops at the first piece type with a legal move, trying the king first.
+ * @param board - the position
+ * @param color - color of the player: WHITE or BLACK
+ * @return true if color has a legal move; false otherwise
+ */
+bool hasLegalMove(const Board& board, int color);
+
+#endif //CHESS_CPP_MOVEGEN_H
\ No newline at end of file
@@ -0,0 +1,72 @@
+// MoveList.h
+
+#ifndef CHESS_CPP_MOVELIST_H
+#define CHESS_CPP_MOVELIST_H
+
+// ------------------------- includes --------------------------
+
+#include <algorithm>
+#include "Move.h"
+
+// --------------------- const definitions ---------------------
+
+// max number of moves in a MoveList. no chess position has more than 218 legal moves.
+constexpr int MAX_MOVES = 256;
+
+// --------------------- class declaration ---------------------
+
+/**
+ * This class represents a fixed-capacity list of moves, meant to live on the stack.
+ */
+class MoveList
+{
+private:
+    Move _moves[MAX_MOVES]; /** the moves in the list */
+    int _size = 0; /** number of moves in the list */
+
+public:
+    /**
+     * @brief adds a move to the end of MoveList. assumes: MoveList holds less than MAX_MOVES moves.
+     * @param move - the move to be added
+     */
+    void add(Move move) {_moves[_size++] = move; }
+
+    /**
+     * @brief swaps the moves at the given indices
+     * @param first - an index between 0 and size() - 1
+     * @param second - an index between 0 and size() - 1
+     */
+    void swap(int first, int second) {std::swap(_moves[first], _moves[second]); }
+
+    /**
+     * @brief empties MoveList
+     */
+    void clear() {_size = 0; }
+
+    /**
+     * @brief returns the number of moves in MoveList
+     * @return number of moves in MoveList
+     */
+    int size() const {return _size; }
+
+    /**
+     * @brief returns the move at the given index
+     * @param index - an index between 0 and size() - 1
+     * @return the move at index
+     */
+    Move operator[](int index) const {return _moves[index]; }
+
+    /**
+     * @brief returns a pointer to the first move, for range-based for loops
+     * @return pointer to the first move in MoveList
+     */
+    const Move* begin() const {return _moves; }
+
+    /**
+     * @brief returns a pointer past the last move, for range-based for loops
+     * @return pointer past the last move in MoveList
+     */
+    const Move* end() const {return _moves + _size; }
+};
+
+#endif //CHESS_CPP_MOVELIST_H
\ No newline at end of file
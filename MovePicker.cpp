@@ -0,0 +1,217 @@
+// MovePicker.cpp
+// This file contains the implementation of the class MovePicker
+
+// ------------------------- includes --------------------------
+
+#include "MovePicker.h"
+
+// --------------------- const definitions ---------------------
+
+// weight of the captured piece over the capturing piece in an MVV-LVA score
+constexpr int VICTIM_WEIGHT = 16;
+
+// ------------------- class implementation --------------------
+
+/**
+ * @brief a constructor for MovePicker
+ * @param board - the position, which must outlive MovePicker
+ * @param hashMove - the move tried first, e.g. from the transposition table; a null move if none.
+ * may be illegal, in which case it's skipped.
+ * @param killers - the KILLER_NUM killer moves of the position's ply; may be illegal
+ * @param history - the history scores of quiet moves
+ */
+MovePicker::MovePicker(const Board& board, Move hashMove, const Move* killers,
+                       const HistoryTable& history):
+        _board(board), _hashMove(hashMove), _killers(killers), _history(&history),
+        _checkers(board.getCheckers(board.getSideToMove())),
+        _pinned(board.getPinned(board.getSideToMove()))
+{
+}
+
+/**
+ * @brief a constructor for a MovePicker of a quiescence search, which returns only the captures
+ * and promotions that don't lose material.
+ * @param board - the position, which must outlive MovePicker
+ */
+MovePicker::MovePicker(const Board& board):
+        _board(board), _killers(nullptr), _history(nullptr),
+        _checkers(board.getCheckers(board.getSideToMove())),
+        _pinned(board.getPinned(board.getSideToMove())), _stage(GENERATE_NOISY_STAGE),
+        _isNoisyOnly(true)
+{
+}
+
+/**
+ * @brief checks whether a move was already returned by an earlier stage
+ * @param move - a move
+ * @return true if move is the hash move or a killer move; false otherwise
+ */
+bool MovePicker::_isSpecial(Move move) const
+{
+    return (move == _hashMove) ||
+           ((_killers != nullptr) && ((move == _killers[0]) || (move == _killers[1])));
+}
+
+/**
+ * @brief checks whether a capture or promotion loses material by static exchange evaluation. a
+ * capture of a piece at least as valuable as the capturing one never does.
+ * @param move - a capture or promotion
+ * @return true if move loses material; false otherwise
+ */
+bool MovePicker::_isLosing(Move move) const
+{
+    Piece* victim = _board.getPiece(move.getDest());
+    int victimValue = (victim == nullptr ? PIECE_VALUES[PAWN]: PIECE_VALUES[victim->getType()]);
+    int attackerValue = PIECE_VALUES[_board.getPiece(move.getSrc())->getType()];
+    if (move.isCapture() && (victimValue >= attackerValue))
+    {
+        return false;
+    }
+    return staticExchange(_board, move) < 0;
+}
+
+/**
+ * @brief scores every move of the current stage: a capture by the value of the captured piece,
+ * and then by the cheapness of the capturing one (MVV-LVA), plus the value of a promotion's
+ * piece; a quiet move by its history score.
+ */
+void MovePicker::_scoreMoves()
+{
+    int color = colorIndex(_board.getSideToMove());
+    for (int i = 0; i < _moves.size(); i++)
+    {
+        Move move = _moves[i];
+        if (_stage == QUIET_STAGE)
+        {
+            _scores[i] = (*_history)[color][move.getSrc()][move.getDest()];
+            continue;
+        }
+        int score = 0;
+        if (move.isCapture())
+        {
+            // an en passant capture's destination is empty, and its victim a pawn
+            Piece* victim = _board.getPiece(move.getDest());
+            PieceType victimType = (victim == nullptr ? PAWN: victim->getType());
+            score += PIECE_VALUES[victimType] * VICTIM_WEIGHT -
+                     PIECE_VALUES[_board.getPiece(move.getSrc())->getType()];
+        }
+        if (move.isPromotion())
+        {
+            score += PIECE_VALUES[move.getPromotionType()] * VICTIM_WEIGHT;
+        }
+        _scores[i] = score;
+    }
+}
+
+/**
+ * @brief returns the best-scored move of the current stage that is left, and removes it: a
+ * selection step, which is cheaper than sorting when an early move causes a cutoff.
+ * @return the move; a null move if the stage is exhausted
+ */
+Move MovePicker::_pickBest()
+{
+    if (_index == _moves.size())
+    {
+        return Move();
+    }
+    int best = _index;
+    for (int i = _index + 1; i < _moves.size(); i++)
+    {
+        best = (_scores[i] > _scores[best] ? i: best);
+    }
+    std::swap(_scores[best], _scores[_index]);
+    _moves.swap(best, _index);
+    return _moves[_index++];
+}
+
+/**
+ * @brief returns the next legal move
+ * @return the next move; a null move once all moves were returned
+ */
+Move MovePicker::next()
+{
+    while (true)
+    {
+        switch (_stage)
+        {
+            case HASH_STAGE:
+                _stage = GENERATE_NOISY_STAGE;
+                if (isPseudoLegal(_board, _hashMove) &&
+                    _board.isLegal(_hashMove, _checkers, _pinned))
+                {
+                    return _hashMove;
+                }
+                break;
+            case GENERATE_NOISY_STAGE:
+            case GENERATE_QUIET_STAGE:
+                _moves.clear();
+                _index = 0;
+                _stage = Stage(_stage + 1);
+                generatePseudoLegalMoves(_board, _moves,
+                                         (_stage == NOISY_STAGE ? NOISY_MOVES: QUIET_MOVES));
+                _scoreMoves();
+                break;
+            case NOISY_STAGE:
+            {
+                Move move = _pickBest();
+                if (move.isNull())
+                {
+                    _index = 0;
+                    _stage = (_isNoisyOnly ? DONE_STAGE: KILLER_STAGE);
+                }
+                else if (_isSpecial(move) || !_board.isLegal(move, _checkers, _pinned))
+                {
+                    break;
+                }
+                else if (!_isLosing(move))
+                {
+                    return move;
+                }
+                else if (!_isNoisyOnly)
+                {
+                    _badNoisy.add(move);
+                }
+                break;
+            }
+            case QUIET_STAGE:
+            {
+                Move move = _pickBest();
+                if (move.isNull())
+                {
+                    _index = 0;
+                    _stage = BAD_NOISY_STAGE;
+                }
+                else if (!_isSpecial(move) && _board.isLegal(move, _checkers, _pinned))
+                {
+                    return move;
+                }
+                break;
+            }
+            case BAD_NOISY_STAGE:
+                if (_index == _badNoisy.size())
+                {
+                    _stage = DONE_STAGE;
+                    break;
+                }
+                return _badNoisy[_index++];
+            case KILLER_STAGE:
+            {
+                if (_index == KILLER_NUM)
+                {
+                    _stage = GENERATE_QUIET_STAGE;
+                    break;
+                }
+                Move killer = _killers[_index++];
+                if ((killer != _hashMove) && isPseudoLegal(_board, killer) &&
+                    !killer.isCapture() && !killer.isPromotion() &&
+                    _board.isLegal(killer, _checkers, _pinned))
+                {
+                    return killer;
+                }
+                break;
+            }
+            case DONE_STAGE:
+                return Move();
+        }
+    }
+}
\ No newline at end of file
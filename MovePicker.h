@@ -0,0 +1,115 @@
+// MovePicker.h
+
+#ifndef CHESS_CPP_MOVEPICKER_H
+#define CHESS_CPP_MOVEPICKER_H
+
+// ------------------------- includes --------------------------
+
+#include "MoveGen.h"
+#include "Evaluate.h"
+
+// --------------------- const definitions ---------------------
+
+// number of killer moves kept per ply
+constexpr int KILLER_NUM = 2;
+
+/**
+ * history scores of quiet moves, indexed by colorIndex(), source square and destination square.
+ * a quiet move scores higher the more often, and the deeper, it has caused a cutoff.
+ */
+typedef int HistoryTable[COLOR_NUM][BOARD_SQUARES][BOARD_SQUARES];
+
+// --------------------- class declaration ---------------------
+
+/**
+ * This class represents a staged generator of the legal moves of a position, in the order in which
+ * the search tries them: the hash move, captures and promotions by MVV-LVA that don't lose
+ * material by static exchange evaluation, the killer moves, quiet moves by their history scores,
+ * and finally the losing captures. every stage is generated only once the previous ones are
+ * exhausted, so a cutoff by an early move saves generating the rest. for a quiescence search,
+ * MovePicker returns only the captures and promotions that don't lose material.
+ */
+class MovePicker
+{
+private:
+    /**
+     * the stages of MovePicker, in order
+     */
+    enum Stage
+    {
+        HASH_STAGE, /** the hash move */
+        GENERATE_NOISY_STAGE, /** generating captures and promotions */
+        NOISY_STAGE, /** captures and promotions, best MVV-LVA first */
+        KILLER_STAGE, /** the killer moves */
+        GENERATE_QUIET_STAGE, /** generating quiet moves */
+        QUIET_STAGE, /** quiet moves, best history score first */
+        BAD_NOISY_STAGE, /** captures that lose material, in the order of NOISY_STAGE */
+        DONE_STAGE /** no moves are left */
+    };
+
+    const Board& _board; /** the position */
+    Move _hashMove; /** the move tried first; a null move if none */
+    const Move* _killers; /** the killer moves of the position's ply; nullptr if none */
+    const HistoryTable* _history; /** the history scores of quiet moves; nullptr if none */
+    Bitboard _checkers; /** getCheckers() of the player to move */
+    Bitboard _pinned; /** getPinned() of the player to move */
+    Stage _stage = HASH_STAGE; /** the current stage */
+    MoveList _moves; /** the moves of the current stage */
+    int _scores[MAX_MOVES]; /** the ordering scores of _moves */
+    int _index = 0; /** index of the next move of the current stage */
+    MoveList _badNoisy; /** the captures of NOISY_STAGE that lose material */
+    bool _isNoisyOnly = false; /** true if only captures and promotions are returned */
+
+    /**
+     * @brief checks whether a move was already returned by an earlier stage
+     * @param move - a move
+     * @return true if move is the hash move or a killer move; false otherwise
+     */
+    bool _isSpecial(Move move) const;
+
+    /**
+     * @brief scores every move of the current stage
+     */
+    void _scoreMoves();
+
+    /**
+     * @brief checks whether a capture or promotion loses material by static exchange evaluation.
+     * a capture of a piece at least as valuable as the capturing one never does.
+     * @param move - a capture or promotion
+     * @return true if move loses material; false otherwise
+     */
+    bool _isLosing(Move move) const;
+
+    /**
+     * @brief returns the best-scored move of the current stage that is left, and removes it
+     * @return the move; a null move if the stage is exhausted
+     */
+    Move _pickBest();
+
+public:
+    /**
+     * @brief a constructor for MovePicker
+     * @param board - the position, which must outlive MovePicker
+     * @param hashMove - the move tried first, e.g. from the transposition table; a null move if
+     * none. may be illegal, in which case it's skipped.
+     * @param killers - the KILLER_NUM killer moves of the position's ply; may be illegal
+     * @param history - the history scores of quiet moves
+     */
+    MovePicker(const Board& board, Move hashMove, const Move* killers,
+               const HistoryTable& history);
+
+    /**
+     * @brief a constructor for a MovePicker of a quiescence search, which returns only the
+     * captures and promotions that don't lose material.
+     * @param board - the position, which must outlive MovePicker
+     */
+    explicit MovePicker(const Board& board);
+
+    /**
+     * @brief returns the next legal move
+     * @return the next move; a null move once all moves were returned
+     */
+    Move next();
+};
+
+#endif //CHESS_CPP_MOVEPICKER_H
\ No newline at end of file
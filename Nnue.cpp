@@ -0,0 +1,727 @@
+// Nnue.cpp
+// This file contains the implementation of the classes Network and NnueEvaluator
+
+// ------------------------- includes --------------------------
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include "Nnue.h"
+#if NNUE_SIMD_SUPPORTED
+#include <immintrin.h>
+#endif
+
+// --------------------- const definitions ---------------------
+
+// environment variable overriding the kernel of the network: "scalar", "sse4.1" or "avx2"
+constexpr auto NNUE_KERNEL_VARIABLE = "CHESS_NNUE_KERNEL";
+// names of the kernels, indexed by NnueKernel
+constexpr const char* NNUE_KERNEL_NAMES[] = {"scalar", "sse4.1", "avx2"};
+// number of int16 values in a 128-bit vector
+constexpr int SSE_INT16_NUM = 8;
+// number of int8 values in a 128-bit vector
+constexpr int SSE_INT8_NUM = 16;
+// number of int16 values in a 256-bit vector
+constexpr int AVX2_INT16_NUM = 16;
+// number of int8 values in a 256-bit vector
+constexpr int AVX2_INT8_NUM = 32;
+
+static_assert(NNUE_ACCUMULATOR_SIZE % AVX2_INT16_NUM == 0, "accumulators fill whole vectors");
+static_assert(NNUE_HIDDEN_SIZE % AVX2_INT8_NUM == 0, "dense layer inputs fill whole vectors");
+
+// ------------------------ static data ------------------------
+
+// the loaded network; nullptr if none was loaded
+static std::unique_ptr<Network> network;
+
+// the selected kernel of the network's arithmetic
+static NnueKernel nnueKernel = SCALAR_KERNEL;
+
+// ----------------- function implementation -------------------
+
+/**
+ * @brief checks whether the CPU runs the given kernel
+ * @param kernel - a kernel
+ * @return true if it does; false otherwise
+ */
+bool isNnueKernelSupported(NnueKernel kernel)
+{
+#if NNUE_SIMD_SUPPORTED
+    __builtin_cpu_init(); // may run in a static initializer, before the CPU model is read
+    switch (kernel)
+    {
+        case AVX2_KERNEL:
+            return __builtin_cpu_supports("avx2");
+        case SSE41_KERNEL:
+            return __builtin_cpu_supports("sse4.1");
+        default:
+            return true;
+    }
+#else
+    return kernel == SCALAR_KERNEL;
+#endif
+}
+
+/**
+ * @brief selects the kernel of the network's arithmetic
+ * @param kernel - the kernel
+ * @return true if the kernel has been selected; false if the CPU doesn't support it
+ */
+bool setNnueKernel(NnueKernel kernel)
+{
+    if (!isNnueKernelSupported(kernel))
+    {
+        return false;
+    }
+    nnueKernel = kernel;
+    return true;
+}
+
+/**
+ * @brief selects the kernel of the network's arithmetic by name
+ * @param name - "scalar", "sse4.1" or "avx2"
+ * @return true if the kernel has been selected; false if name is unknown or the CPU doesn't
+ * support it
+ */
+bool setNnueKernel(const char* name)
+{
+    for (int kernel = SCALAR_KERNEL; kernel <= AVX2_KERNEL; kernel++)
+    {
+        if (std::strcmp(name, NNUE_KERNEL_NAMES[kernel]) == 0)
+        {
+            return setNnueKernel(NnueKernel(kernel));
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief returns the name of the selected kernel
+ * @return "scalar", "sse4.1" or "avx2"
+ */
+const char* nnueKernelName()
+{
+    return NNUE_KERNEL_NAMES[nnueKernel];
+}
+
+/**
+ * This struct selects the kernel of the network before main runs: the widest one the CPU
+ * supports, unless the environment variable CHESS_NNUE_KERNEL names another kernel.
+ */
+static struct NnueKernelInitializer
+{
+    NnueKernelInitializer()
+    {
+        const char* name = std::getenv(NNUE_KERNEL_VARIABLE);
+        if ((name != nullptr) && setNnueKernel(name))
+        {
+            return;
+        }
+        for (int kernel = AVX2_KERNEL; !setNnueKernel(NnueKernel(kernel)); kernel--)
+        {
+        }
+    }
+} nnueKernelInitializer;
+
+/**
+ * @brief loads the network that evaluates positions in place of the handcrafted evaluation
+ * @param path - path of a network file
+ * @return true if the network has been loaded; false if the file can't be read, in which case the
+ * previously loaded network, if any, is kept.
+ */
+bool loadNetwork(const string& path)
+{
+    auto loaded = std::make_unique<Network>();
+    if (!loaded->load(path))
+    {
+        return false;
+    }
+    network = std::move(loaded);
+    return true;
+}
+
+/**
+ * @brief returns the loaded network
+ * @return the network; nullptr if none was loaded
+ */
+const Network* getNetwork()
+{
+    return network.get();
+}
+
+/**
+ * @brief reads an array of little-endian values from a stream
+ * @param in - the stream
+ * @param values - the array, which is assigned the values read
+ * @param count - number of values in the array
+ * @return true if all values have been read; false otherwise
+ */
+template <typename T>
+static bool _read(std::istream& in, T* values, size_t count)
+{
+    return bool(in.read(reinterpret_cast<char*>(values), std::streamsize(sizeof(T) * count)));
+}
+
+/**
+ * @brief clips a sum into an 8-bit activation (a clipped ReLU)
+ * @param sum - the sum
+ * @return sum, clipped to [0, NNUE_ACTIVATION_MAX]
+ */
+static uint8_t _clip(int sum)
+{
+    return uint8_t(std::min(std::max(sum, 0), NNUE_ACTIVATION_MAX));
+}
+
+/**
+ * @brief computes accumulator values from others, with plain C++
+ * @param previous - the values to start from
+ * @param removed - indices of the features whose weights are subtracted
+ * @param removedNum - number of removed features
+ * @param added - indices of the features whose weights are added
+ * @param addedNum - number of added features
+ * @param weights - the feature weights, NNUE_ACCUMULATOR_SIZE per feature
+ * @param values - the computed values; may be previous
+ */
+static void _updateScalar(const int16_t* previous, const int* removed, int removedNum,
+                          const int* added, int addedNum, const int16_t* weights, int16_t* values)
+{
+    if (values != previous)
+    {
+        std::copy(previous, previous + NNUE_ACCUMULATOR_SIZE, values);
+    }
+    for (int i = 0; i < removedNum; i++)
+    {
+        const int16_t* featureWeights = weights + size_t(removed[i]) * NNUE_ACCUMULATOR_SIZE;
+        for (int j = 0; j < NNUE_ACCUMULATOR_SIZE; j++)
+        {
+            values[j] = int16_t(values[j] - featureWeights[j]);
+        }
+    }
+    for (int i = 0; i < addedNum; i++)
+    {
+        const int16_t* featureWeights = weights + size_t(added[i]) * NNUE_ACCUMULATOR_SIZE;
+        for (int j = 0; j < NNUE_ACCUMULATOR_SIZE; j++)
+        {
+            values[j] = int16_t(values[j] + featureWeights[j]);
+        }
+    }
+}
+
+/**
+ * @brief computes the outputs of a dense layer, with plain C++
+ * @param input - the 8-bit activations of the previous layer
+ * @param inputNum - number of inputs
+ * @param weights - the weights, inputNum per output
+ * @param biases - the biases, one per output
+ * @param outputNum - number of outputs
+ * @param outputs - the computed sums, one per output
+ */
+static void _denseScalar(const uint8_t* input, int inputNum, const int8_t* weights,
+                         const int32_t* biases, int outputNum, int32_t* outputs)
+{
+    for (int i = 0; i < outputNum; i++)
+    {
+        int32_t sum = biases[i];
+        for (int j = 0; j < inputNum; j++)
+        {
+            sum += input[j] * weights[i * inputNum + j];
+        }
+        outputs[i] = sum;
+    }
+}
+
+#if NNUE_SIMD_SUPPORTED
+
+/**
+ * @brief computes accumulator values from others, 8 values at a time with SSE4.1
+ * @param previous - the values to start from
+ * @param removed - indices of the features whose weights are subtracted
+ * @param removedNum - number of removed features
+ * @param added - indices of the features whose weights are added
+ * @param addedNum - number of added features
+ * @param weights - the feature weights, NNUE_ACCUMULATOR_SIZE per feature
+ * @param values - the computed values; may be previous
+ */
+__attribute__((target("sse4.1")))
+static void _updateSse41(const int16_t* previous, const int* removed, int removedNum,
+                         const int* added, int addedNum, const int16_t* weights, int16_t* values)
+{
+    for (int j = 0; j < NNUE_ACCUMULATOR_SIZE; j += SSE_INT16_NUM)
+    {
+        __m128i sum = _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous + j));
+        for (int i = 0; i < removedNum; i++)
+        {
+            const int16_t* featureWeights = weights + size_t(removed[i]) * NNUE_ACCUMULATOR_SIZE;
+            sum = _mm_sub_epi16(sum, _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(featureWeights + j)));
+        }
+        for (int i = 0; i < addedNum; i++)
+        {
+            const int16_t* featureWeights = weights + size_t(added[i]) * NNUE_ACCUMULATOR_SIZE;
+            sum = _mm_add_epi16(sum, _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(featureWeights + j)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values + j), sum);
+    }
+}
+
+/**
+ * @brief computes accumulator values from others, 16 values at a time with AVX2
+ * @param previous - the values to start from
+ * @param removed - indices of the features whose weights are subtracted
+ * @param removedNum - number of removed features
+ * @param added - indices of the features whose weights are added
+ * @param addedNum - number of added features
+ * @param weights - the feature weights, NNUE_ACCUMULATOR_SIZE per feature
+ * @param values - the computed values; may be previous
+ */
+__attribute__((target("avx2")))
+static void _updateAvx2(const int16_t* previous, const int* removed, int removedNum,
+                        const int* added, int addedNum, const int16_t* weights, int16_t* values)
+{
+    for (int j = 0; j < NNUE_ACCUMULATOR_SIZE; j += AVX2_INT16_NUM)
+    {
+        __m256i sum = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(previous + j));
+        for (int i = 0; i < removedNum; i++)
+        {
+            const int16_t* featureWeights = weights + size_t(removed[i]) * NNUE_ACCUMULATOR_SIZE;
+            sum = _mm256_sub_epi16(sum, _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(featureWeights + j)));
+        }
+        for (int i = 0; i < addedNum; i++)
+        {
+            const int16_t* featureWeights = weights + size_t(added[i]) * NNUE_ACCUMULATOR_SIZE;
+            sum = _mm256_add_epi16(sum, _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(featureWeights + j)));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + j), sum);
+    }
+}
+
+/**
+ * @brief computes the outputs of a dense layer, 16 inputs at a time with SSE4.1: unsigned inputs
+ * times signed weights are summed in pairs into 16 bits (which can't overflow, as the inputs are
+ * at most NNUE_ACTIVATION_MAX), and then in pairs into 32 bits.
+ * @param input - the 8-bit activations of the previous layer
+ * @param inputNum - number of inputs, a multiple of 16
+ * @param weights - the weights, inputNum per output
+ * @param biases - the biases, one per output
+ * @param outputNum - number of outputs
+ * @param outputs - the computed sums, one per output
+ */
+__attribute__((target("sse4.1")))
+static void _denseSse41(const uint8_t* input, int inputNum, const int8_t* weights,
+                        const int32_t* biases, int outputNum, int32_t* outputs)
+{
+    const __m128i ones = _mm_set1_epi16(1);
+    for (int i = 0; i < outputNum; i++)
+    {
+        __m128i sum = _mm_setzero_si128();
+        for (int j = 0; j < inputNum; j += SSE_INT8_NUM)
+        {
+            __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + j));
+            __m128i weight = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(weights + i * inputNum + j));
+            __m128i products = _mm_maddubs_epi16(in, weight);
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(products, ones));
+        }
+        sum = _mm_hadd_epi32(sum, sum);
+        sum = _mm_hadd_epi32(sum, sum);
+        outputs[i] = biases[i] + _mm_cvtsi128_si32(sum);
+    }
+}
+
+/**
+ * @brief computes the outputs of a dense layer, 32 inputs at a time with AVX2: unsigned inputs
+ * times signed weights are summed in pairs into 16 bits (which can't overflow, as the inputs are
+ * at most NNUE_ACTIVATION_MAX), and then in pairs into 32 bits.
+ * @param input - the 8-bit activations of the previous layer
+ * @param inputNum - number of inputs, a multiple of 32
+ * @param weights - the weights, inputNum per output
+ * @param biases - the biases, one per output
+ * @param outputNum - number of outputs
+ * @param outputs - the computed sums, one per output
+ */
+__attribute__((target("avx2")))
+static void _denseAvx2(const uint8_t* input, int inputNum, const int8_t* weights,
+                       const int32_t* biases, int outputNum, int32_t* outputs)
+{
+    const __m256i ones = _mm256_set1_epi16(1);
+    for (int i = 0; i < outputNum; i++)
+    {
+        __m256i sum = _mm256_setzero_si256();
+        for (int j = 0; j < inputNum; j += AVX2_INT8_NUM)
+        {
+            __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + j));
+            __m256i weight = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(weights + i * inputNum + j));
+            __m256i products = _mm256_maddubs_epi16(in, weight);
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(products, ones));
+        }
+        __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                                     _mm256_extracti128_si256(sum, 1));
+        half = _mm_hadd_epi32(half, half);
+        half = _mm_hadd_epi32(half, half);
+        outputs[i] = biases[i] + _mm_cvtsi128_si32(half);
+    }
+}
+
+#endif
+
+/**
+ * @brief computes accumulator values from others, with the selected kernel
+ * @param previous - the values to start from
+ * @param removed - indices of the features whose weights are subtracted
+ * @param removedNum - number of removed features
+ * @param added - indices of the features whose weights are added
+ * @param addedNum - number of added features
+ * @param weights - the feature weights, NNUE_ACCUMULATOR_SIZE per feature
+ * @param values - the computed values; may be previous
+ */
+static void _update(const int16_t* previous, const int* removed, int removedNum, const int* added,
+                    int addedNum, const int16_t* weights, int16_t* values)
+{
+#if NNUE_SIMD_SUPPORTED
+    if (nnueKernel == AVX2_KERNEL)
+    {
+        _updateAvx2(previous, removed, removedNum, added, addedNum, weights, values);
+        return;
+    }
+    if (nnueKernel == SSE41_KERNEL)
+    {
+        _updateSse41(previous, removed, removedNum, added, addedNum, weights, values);
+        return;
+    }
+#endif
+    _updateScalar(previous, removed, removedNum, added, addedNum, weights, values);
+}
+
+/**
+ * @brief computes the outputs of a dense layer, with the selected kernel
+ * @param input - the 8-bit activations of the previous layer
+ * @param inputNum - number of inputs, a multiple of 32
+ * @param weights - the weights, inputNum per output
+ * @param biases - the biases, one per output
+ * @param outputNum - number of outputs
+ * @param outputs - the computed sums, one per output
+ */
+static void _dense(const uint8_t* input, int inputNum, const int8_t* weights,
+                   const int32_t* biases, int outputNum, int32_t* outputs)
+{
+#if NNUE_SIMD_SUPPORTED
+    if (nnueKernel == AVX2_KERNEL)
+    {
+        _denseAvx2(input, inputNum, weights, biases, outputNum, outputs);
+        return;
+    }
+    if (nnueKernel == SSE41_KERNEL)
+    {
+        _denseSse41(input, inputNum, weights, biases, outputNum, outputs);
+        return;
+    }
+#endif
+    _denseScalar(input, inputNum, weights, biases, outputNum, outputs);
+}
+
+// ------------------- class implementation --------------------
+
+/**
+ * @brief a constructor for Network. its weights are undefined until it's loaded.
+ */
+Network::Network():
+        _featureWeights(new int16_t[size_t(NNUE_FEATURES) * NNUE_ACCUMULATOR_SIZE])
+{
+}
+
+/**
+ * @brief reads the weights of Network from a network file
+ * @param path - path of the file
+ * @return true if the file has been read; false if it can't be opened or doesn't match the
+ * format, in which case Network is left with undefined weights.
+ */
+bool Network::load(const string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    uint32_t header[4];
+    if (!_read(in, header, 4) || (header[0] != NNUE_FILE_MAGIC) ||
+        (header[1] != NNUE_FILE_VERSION) || (header[2] != NNUE_ACCUMULATOR_SIZE) ||
+        (header[3] != NNUE_HIDDEN_SIZE))
+    {
+        return false;
+    }
+    return _read(in, _featureBiases, NNUE_ACCUMULATOR_SIZE) &&
+           _read(in, _featureWeights.get(), size_t(NNUE_FEATURES) * NNUE_ACCUMULATOR_SIZE) &&
+           _read(in, _hidden1Biases, NNUE_HIDDEN_SIZE) &&
+           _read(in, &_hidden1Weights[0][0], NNUE_HIDDEN_SIZE * NNUE_DENSE_INPUTS) &&
+           _read(in, _hidden2Biases, NNUE_HIDDEN_SIZE) &&
+           _read(in, &_hidden2Weights[0][0], NNUE_HIDDEN_SIZE * NNUE_HIDDEN_SIZE) &&
+           _read(in, &_outputBias, 1) && _read(in, _outputWeights, NNUE_HIDDEN_SIZE) &&
+           (in.peek() == std::ifstream::traits_type::eof());
+}
+
+/**
+ * @brief fills Network with small pseudo-random weights, which keep most activations inside the
+ * clipping range, so that the network's arithmetic can be checked without a network file
+ * @param seed - seed of the weights; the same seed always gives the same weights
+ */
+void Network::randomize(uint64_t seed)
+{
+    auto random = [&seed](int max) {return int(_nextRandom(seed) % (2 * max + 1)) - max; };
+    std::fill(_featureBiases, _featureBiases + NNUE_ACCUMULATOR_SIZE, NNUE_RANDOM_FEATURE_BIAS);
+    for (size_t i = 0; i < size_t(NNUE_FEATURES) * NNUE_ACCUMULATOR_SIZE; i++)
+    {
+        _featureWeights[i] = int16_t(random(NNUE_RANDOM_FEATURE_WEIGHT));
+    }
+    for (int i = 0; i < NNUE_HIDDEN_SIZE; i++)
+    {
+        _hidden1Biases[i] = _hidden2Biases[i] = 0;
+        _outputWeights[i] = int8_t(random(NNUE_RANDOM_DENSE_WEIGHT));
+        for (int8_t& weight: _hidden1Weights[i])
+        {
+            weight = int8_t(random(NNUE_RANDOM_DENSE_WEIGHT));
+        }
+        for (int8_t& weight: _hidden2Weights[i])
+        {
+            weight = int8_t(random(NNUE_RANDOM_DENSE_WEIGHT));
+        }
+    }
+    _outputBias = 0;
+}
+
+/**
+ * @brief returns the index of a feature
+ * @param perspective - color of the player viewing the board: WHITE or BLACK
+ * @param king - square of the player's king
+ * @param color - color of the piece: WHITE or BLACK
+ * @param type - type of the piece. assumes: type isn't KING.
+ * @param square - square of the piece
+ * @return the index, less than NNUE_FEATURES
+ */
+int Network::featureIndex(int perspective, Square king, int color, PieceType type, Square square)
+{
+    if (perspective == BLACK)
+    {
+        king = Square(king ^ MIRROR_RANKS);
+        square = Square(square ^ MIRROR_RANKS);
+    }
+    int kind = 2 * type + (color == perspective ? 0: 1);
+    return (king * NNUE_PIECE_KINDS + kind) * BOARD_SQUARES + square;
+}
+
+/**
+ * @brief computes one perspective of an accumulator from scratch
+ * @param board - the position
+ * @param perspective - color of the player viewing the board: WHITE or BLACK
+ * @param accumulator - non-const ref, whose perspective's values are computed
+ */
+void Network::refresh(const Board& board, int perspective, Accumulator& accumulator) const
+{
+    Square king = board.getKing(perspective)->getPosition();
+    int features[BOARD_SQUARES];
+    int featureNum = 0;
+    for (int color: {WHITE, BLACK})
+    {
+        for (int type = PAWN; type < KING; type++)
+        {
+            Bitboard pieces = board.getPieces(color, PieceType(type));
+            while (pieces)
+            {
+                Square square = popLsb(pieces);
+                features[featureNum++] = featureIndex(perspective, king, color, PieceType(type),
+                                                      square);
+            }
+        }
+    }
+    int index = colorIndex(perspective);
+    _update(_featureBiases, nullptr, 0, features, featureNum, _featureWeights.get(),
+            accumulator.values[index]);
+    accumulator.isComputed[index] = true;
+}
+
+/**
+ * @brief computes one perspective of an accumulator from that of the previous position, by
+ * subtracting the weights of the removed features and adding those of the added ones.
+ * @param previous - values of the perspective in the previous position
+ * @param removed - indices of the removed features
+ * @param removedNum - number of removed features, at most NNUE_MAX_REMOVED
+ * @param added - indices of the added features
+ * @param addedNum - number of added features, at most NNUE_MAX_ADDED
+ * @param values - values of the perspective in the new position, which are computed
+ */
+void Network::update(const int16_t* previous, const int* removed, int removedNum,
+                     const int* added, int addedNum, int16_t* values) const
+{
+    _update(previous, removed, removedNum, added, addedNum, _featureWeights.get(), values);
+}
+
+/**
+ * @brief runs the dense layers of the network
+ * @param accumulator - the position's accumulator. assumes: both perspectives are computed.
+ * @param color - color of the player to move: WHITE or BLACK
+ * @return score of the position in centipawns, from the point of view of the player to move
+ */
+int Network::evaluate(const Accumulator& accumulator, int color) const
+{
+    // the player to move's accumulator comes first, so that the network sees whose turn it is
+    alignas(32) uint8_t input[NNUE_DENSE_INPUTS];
+    const int16_t* perspectives[COLOR_NUM] = {accumulator.values[colorIndex(color)],
+                                              accumulator.values[colorIndex(color * REVERSE)]};
+    for (int i = 0; i < COLOR_NUM; i++)
+    {
+        for (int j = 0; j < NNUE_ACCUMULATOR_SIZE; j++)
+        {
+            input[i * NNUE_ACCUMULATOR_SIZE + j] = _clip(perspectives[i][j]);
+        }
+    }
+
+    int32_t sums[NNUE_HIDDEN_SIZE];
+    alignas(32) uint8_t hidden1[NNUE_HIDDEN_SIZE];
+    _dense(input, NNUE_DENSE_INPUTS, &_hidden1Weights[0][0], _hidden1Biases, NNUE_HIDDEN_SIZE,
+           sums);
+    for (int i = 0; i < NNUE_HIDDEN_SIZE; i++)
+    {
+        hidden1[i] = _clip(sums[i] >> NNUE_WEIGHT_SHIFT);
+    }
+    alignas(32) uint8_t hidden2[NNUE_HIDDEN_SIZE];
+    _dense(hidden1, NNUE_HIDDEN_SIZE, &_hidden2Weights[0][0], _hidden2Biases, NNUE_HIDDEN_SIZE,
+           sums);
+    for (int i = 0; i < NNUE_HIDDEN_SIZE; i++)
+    {
+        hidden2[i] = _clip(sums[i] >> NNUE_WEIGHT_SHIFT);
+    }
+    int32_t output;
+    _dense(hidden2, NNUE_HIDDEN_SIZE, _outputWeights, &_outputBias, 1, &output);
+    return output / NNUE_OUTPUT_SCALE;
+}
+
+/**
+ * @brief a constructor for NnueEvaluator. the stack is empty until it's reset.
+ * @param network - the network, which must outlive NnueEvaluator
+ */
+NnueEvaluator::NnueEvaluator(const Network& network):
+        _network(network), _stack(new Accumulator[MAX_HISTORY + 1])
+{
+}
+
+/**
+ * @brief empties the stack and pushes the accumulator of a root position, computed from scratch
+ * @param board - the root position
+ */
+void NnueEvaluator::reset(const Board& board)
+{
+    _network.refresh(board, WHITE, _stack[0]);
+    _network.refresh(board, BLACK, _stack[0]);
+    _size = 1;
+}
+
+/**
+ * @brief pushes the accumulator of the position after a move, to be called before the move is
+ * made: every perspective whose king stays put subtracts the features the move removes, and adds
+ * those it adds. a stale perspective of the position before the move is computed first, so that
+ * it's computed once for all its children.
+ * @param board - the position before the move
+ * @param move - the move. assumes: move is pseudo-legal in board.
+ */
+void NnueEvaluator::push(const Board& board, Move move)
+{
+    Accumulator& previous = _stack[_size - 1];
+    Accumulator& next = _stack[_size];
+    _size++;
+    int color = board.getSideToMove();
+    Square src = move.getSrc(), dest = move.getDest();
+    PieceType type = board.getPiece(src)->getType();
+    for (int perspective: {WHITE, BLACK})
+    {
+        int index = colorIndex(perspective);
+        next.isComputed[index] = ((type != KING) || (perspective != color));
+        if (!next.isComputed[index])
+        {
+            continue;
+        }
+        if (!previous.isComputed[index])
+        {
+            _network.refresh(board, perspective, previous);
+        }
+        Square king = board.getKing(perspective)->getPosition();
+        int removed[NNUE_MAX_REMOVED], added[NNUE_MAX_ADDED];
+        int removedNum = 0, addedNum = 0;
+        if (move.isCastling())
+        {
+            Square rookSrc, rookDest;
+            Board::getCastlingRook(move, rookSrc, rookDest);
+            removed[removedNum++] = Network::featureIndex(perspective, king, color, ROOK, rookSrc);
+            added[addedNum++] = Network::featureIndex(perspective, king, color, ROOK, rookDest);
+        }
+        else if (type != KING)
+        {
+            PieceType newType = (move.isPromotion() ? move.getPromotionType(): type);
+            removed[removedNum++] = Network::featureIndex(perspective, king, color, type, src);
+            added[addedNum++] = Network::featureIndex(perspective, king, color, newType, dest);
+        }
+        if (move.isCapture())
+        {
+            Square captured = Board::getCapturedSquare(move, color);
+            removed[removedNum++] = Network::featureIndex(perspective, king, color * REVERSE,
+                                                          board.getPiece(captured)->getType(),
+                                                          captured);
+        }
+        _network.update(previous.values[index], removed, removedNum, added, addedNum,
+                        next.values[index]);
+    }
+}
+
+/**
+ * @brief pushes the accumulator of the position after a null move, which is the same as the one
+ * before it.
+ */
+void NnueEvaluator::pushNull()
+{
+    _stack[_size] = _stack[_size - 1];
+    _size++;
+}
+
+/**
+ * @brief evaluates the latest position, computing its stale perspectives first
+ * @param board - the latest position
+ * @return score of the position in centipawns, from the point of view of the player to move
+ */
+int NnueEvaluator::evaluate(const Board& board)
+{
+    Accumulator& accumulator = _stack[_size - 1];
+    for (int perspective: {WHITE, BLACK})
+    {
+        if (!accumulator.isComputed[colorIndex(perspective)])
+        {
+            _network.refresh(board, perspective, accumulator);
+        }
+    }
+    return _network.evaluate(accumulator, board.getSideToMove());
+}
+
+/**
+ * @brief checks that every computed perspective of the latest accumulator equals the one computed
+ * from scratch
+ * @param board - the latest position
+ * @return true if they're equal; false otherwise
+ */
+bool NnueEvaluator::matchesRefresh(const Board& board) const
+{
+    const Accumulator& accumulator = _stack[_size - 1];
+    Accumulator refreshed;
+    for (int perspective: {WHITE, BLACK})
+    {
+        int index = colorIndex(perspective);
+        if (!accumulator.isComputed[index])
+        {
+            continue;
+        }
+        _network.refresh(board, perspective, refreshed);
+        const int16_t* values = accumulator.values[index];
+        if (!std::equal(values, values + NNUE_ACCUMULATOR_SIZE, refreshed.values[index]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
\ No newline at end of file
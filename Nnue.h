@@ -0,0 +1,276 @@
+// Nnue.h
+
+#ifndef CHESS_CPP_NNUE_H
+#define CHESS_CPP_NNUE_H
+
+// ------------------------- includes --------------------------
+
+#include <memory>
+#include "Board.h"
+
+// --------------------- const definitions ---------------------
+
+// number of kinds of pieces a feature tells apart: every type but the king, of either color
+constexpr int NNUE_PIECE_KINDS = 2 * KING;
+// number of input features of a perspective: its king's square, and another piece on a square
+constexpr int NNUE_FEATURES = BOARD_SQUARES * NNUE_PIECE_KINDS * BOARD_SQUARES;
+// number of neurons in the accumulator of a perspective
+constexpr int NNUE_ACCUMULATOR_SIZE = 256;
+// number of inputs of the first dense layer: the accumulators of both perspectives
+constexpr int NNUE_DENSE_INPUTS = COLOR_NUM * NNUE_ACCUMULATOR_SIZE;
+// number of neurons in each of the two dense hidden layers
+constexpr int NNUE_HIDDEN_SIZE = 32;
+// activations are clipped to [0, NNUE_ACTIVATION_MAX], so that they fit in 8 bits
+constexpr int NNUE_ACTIVATION_MAX = 127;
+// the sums of a dense hidden layer are shifted right by this many bits before they're clipped
+constexpr int NNUE_WEIGHT_SHIFT = 6;
+// the output of the network is divided by this to give centipawns
+constexpr int NNUE_OUTPUT_SCALE = 16;
+// max number of features a move removes from a perspective: its piece (or castling rook) and a
+// captured piece. kings aren't features.
+constexpr int NNUE_MAX_REMOVED = 2;
+// max number of features a move adds to a perspective: its piece, promoted piece or castling rook
+constexpr int NNUE_MAX_ADDED = 1;
+// first 4 bytes of a network file: "NNUE" when read as little-endian
+constexpr uint32_t NNUE_FILE_MAGIC = 0x45554E4E;
+// version of the network file format
+constexpr uint32_t NNUE_FILE_VERSION = 1;
+// max absolute value of a feature weight of a randomized network
+constexpr int NNUE_RANDOM_FEATURE_WEIGHT = 8;
+// max absolute value of a dense layer weight of a randomized network
+constexpr int NNUE_RANDOM_DENSE_WEIGHT = 8;
+// accumulator bias of a randomized network, half way through the activation range
+constexpr int16_t NNUE_RANDOM_FEATURE_BIAS = NNUE_ACTIVATION_MAX / 2;
+
+// whether the SIMD kernels can be compiled, i.e. the target is x86-64 and the compiler takes
+// GNU target attributes. whether the CPU runs them is checked at runtime.
+#if defined(__x86_64__) && defined(__GNUC__)
+#define NNUE_SIMD_SUPPORTED 1
+#else
+#define NNUE_SIMD_SUPPORTED 0
+#endif
+
+/**
+ * the implementations of the network's arithmetic
+ */
+enum NnueKernel
+{
+    SCALAR_KERNEL, /** plain C++: portable */
+    SSE41_KERNEL, /** 128-bit SSE4.1 vectors */
+    AVX2_KERNEL /** 256-bit AVX2 vectors */
+};
+
+// --------------------- struct declaration --------------------
+
+/**
+ * the first layer of the network for a position: the sum of the feature weights of its active
+ * features, plus the biases, from the point of view of each player.
+ */
+struct Accumulator
+{
+    /** indexed by colorIndex() of the perspective */
+    alignas(32) int16_t values[COLOR_NUM][NNUE_ACCUMULATOR_SIZE];
+    /** indexed by colorIndex() of the perspective; false while the values are stale */
+    bool isComputed[COLOR_NUM];
+};
+
+// --------------------- class declaration ---------------------
+
+/**
+ * This class represents a small quantized neural network evaluating a position (NNUE). every
+ * player's view of the position is a set of HalfKP features: one per piece other than the kings,
+ * telling its type, its color relative to the player, its square and the player's king square.
+ * the first layer sums int16 weights of the active features into an accumulator per player; the
+ * accumulators of the player to move and of the opponent, clipped to 8 bits, go through two
+ * dense hidden layers of int8 weights and a single output neuron.
+ *
+ * a network file holds, little-endian and in this order: NNUE_FILE_MAGIC, NNUE_FILE_VERSION,
+ * NNUE_ACCUMULATOR_SIZE and NNUE_HIDDEN_SIZE as uint32; the accumulator biases as int16 and the
+ * feature weights as int16, feature-major; then for each dense layer (the two hidden layers and
+ * the output) its int32 biases followed by its int8 weights, output-major. features are indexed
+ * by featureIndex(), in which black sees the board mirrored vertically.
+ */
+class Network
+{
+private:
+    std::unique_ptr<int16_t[]> _featureWeights; /** NNUE_ACCUMULATOR_SIZE per feature */
+    alignas(32) int16_t _featureBiases[NNUE_ACCUMULATOR_SIZE]; /** biases of the accumulator */
+    alignas(32) int8_t _hidden1Weights[NNUE_HIDDEN_SIZE][NNUE_DENSE_INPUTS]; /** first layer */
+    int32_t _hidden1Biases[NNUE_HIDDEN_SIZE]; /** biases of the first hidden layer */
+    alignas(32) int8_t _hidden2Weights[NNUE_HIDDEN_SIZE][NNUE_HIDDEN_SIZE]; /** second layer */
+    int32_t _hidden2Biases[NNUE_HIDDEN_SIZE]; /** biases of the second hidden layer */
+    alignas(32) int8_t _outputWeights[NNUE_HIDDEN_SIZE]; /** weights of the output neuron */
+    int32_t _outputBias; /** bias of the output neuron */
+
+public:
+    /**
+     * @brief a constructor for Network. its weights are undefined until it's loaded.
+     */
+    Network();
+
+    /**
+     * @brief reads the weights of Network from a network file
+     * @param path - path of the file
+     * @return true if the file has been read; false if it can't be opened or doesn't match the
+     * format, in which case Network is left with undefined weights.
+     */
+    bool load(const string& path);
+
+    /**
+     * @brief fills Network with small pseudo-random weights, which keep most activations inside
+     * the clipping range, so that the network's arithmetic can be checked without a network file
+     * @param seed - seed of the weights; the same seed always gives the same weights
+     */
+    void randomize(uint64_t seed);
+
+    /**
+     * @brief returns the index of a feature
+     * @param perspective - color of the player viewing the board: WHITE or BLACK
+     * @param king - square of the player's king
+     * @param color - color of the piece: WHITE or BLACK
+     * @param type - type of the piece. assumes: type isn't KING.
+     * @param square - square of the piece
+     * @return the index, less than NNUE_FEATURES
+     */
+    static int featureIndex(int perspective, Square king, int color, PieceType type,
+                            Square square);
+
+    /**
+     * @brief computes one perspective of an accumulator from scratch
+     * @param board - the position
+     * @param perspective - color of the player viewing the board: WHITE or BLACK
+     * @param accumulator - non-const ref, whose perspective's values are computed
+     */
+    void refresh(const Board& board, int perspective, Accumulator& accumulator) const;
+
+    /**
+     * @brief computes one perspective of an accumulator from that of the previous position, by
+     * subtracting the weights of the removed features and adding those of the added ones.
+     * @param previous - values of the perspective in the previous position
+     * @param removed - indices of the removed features
+     * @param removedNum - number of removed features, at most NNUE_MAX_REMOVED
+     * @param added - indices of the added features
+     * @param addedNum - number of added features, at most NNUE_MAX_ADDED
+     * @param values - values of the perspective in the new position, which are computed
+     */
+    void update(const int16_t* previous, const int* removed, int removedNum, const int* added,
+                int addedNum, int16_t* values) const;
+
+    /**
+     * @brief runs the dense layers of the network
+     * @param accumulator - the position's accumulator. assumes: both perspectives are computed.
+     * @param color - color of the player to move: WHITE or BLACK
+     * @return score of the position in centipawns, from the point of view of the player to move
+     */
+    int evaluate(const Accumulator& accumulator, int color) const;
+};
+
+/**
+ * This class keeps the accumulators of a search's positions in a stack, one per ply: a move pushes
+ * the accumulator of the new position, computed incrementally from the one below, and unmaking it
+ * pops. a move of a king changes every feature of its own player, so that perspective is left
+ * stale, and computed from scratch only once the position is evaluated or a move is made from
+ * it. an NnueEvaluator isn't thread-safe; every search thread owns one.
+ */
+class NnueEvaluator
+{
+private:
+    const Network& _network; /** the network */
+    std::unique_ptr<Accumulator[]> _stack; /** accumulators of the positions, from the root */
+    int _size = 0; /** number of accumulators in _stack */
+
+public:
+    /**
+     * @brief a constructor for NnueEvaluator. the stack is empty until it's reset.
+     * @param network - the network, which must outlive NnueEvaluator
+     */
+    explicit NnueEvaluator(const Network& network);
+
+    /**
+     * @brief empties the stack and pushes the accumulator of a root position, computed from
+     * scratch
+     * @param board - the root position
+     */
+    void reset(const Board& board);
+
+    /**
+     * @brief pushes the accumulator of the position after a move, to be called before the move
+     * is made. stale perspectives of the position before the move are computed first. assumes:
+     * less than MAX_HISTORY accumulators were pushed since the reset.
+     * @param board - the position before the move
+     * @param move - the move. assumes: move is pseudo-legal in board.
+     */
+    void push(const Board& board, Move move);
+
+    /**
+     * @brief pushes the accumulator of the position after a null move, which is the same as the
+     * one before it.
+     */
+    void pushNull();
+
+    /**
+     * @brief pops the accumulator of the latest position, to be called when its move is unmade.
+     */
+    void pop() {_size--; }
+
+    /**
+     * @brief evaluates the latest position, computing its stale perspectives first
+     * @param board - the latest position
+     * @return score of the position in centipawns, from the point of view of the player to move
+     */
+    int evaluate(const Board& board);
+
+    /**
+     * @brief checks that every computed perspective of the latest accumulator equals the one
+     * computed from scratch
+     * @param board - the latest position
+     * @return true if they're equal; false otherwise
+     */
+    bool matchesRefresh(const Board& board) const;
+};
+
+// ------------------- function declarations -------------------
+
+/**
+ * @brief returns whether the CPU runs the given kernel
+ * @param kernel - a kernel
+ * @return true if it does; false otherwise
+ */
+bool isNnueKernelSupported(NnueKernel kernel);
+
+/**
+ * @brief selects the kernel of the network's arithmetic
+ * @param kernel - the kernel
+ * @return true if the kernel has been selected; false if the CPU doesn't support it
+ */
+bool setNnueKernel(NnueKernel kernel);
+
+/**
+ * @brief selects the kernel of the network's arithmetic by name
+ * @param name - "scalar", "sse4.1" or "avx2"
+ * @return true if the kernel has been selected; false if name is unknown or the CPU doesn't
+ * support it
+ */
+bool setNnueKernel(const char* name);
+
+/**
+ * @brief returns the name of the selected kernel
+ * @return "scalar", "sse4.1" or "avx2"
+ */
+const char* nnueKernelName();
+
+/**
+ * @brief loads the network that evaluates positions in place of the handcrafted evaluation
+ * @param path - path of a network file
+ * @return true if the network has been loaded; false if the file can't be read, in which case
+ * the previously loaded network, if any, is kept.
+ */
+bool loadNetwork(const string& path);
+
+/**
+ * @brief returns the loaded network
+ * @return the network; nullptr if none was loaded
+ */
+const Network* getNetwork();
+
+#endif //CHESS_CPP_NNUE_H
\ No newline at end of file
@@ -0,0 +1,169 @@
+// ParallelPerft.cpp
+// This file contains the implementation of the class ParallelPerft
+
+// ------------------------- includes --------------------------
+
+#include <thread>
+#include <vector>
+#include "ParallelPerft.h"
+
+using std::vector;
+
+// --------------------- const definitions ---------------------
+
+// a task whose remaining depth is at most this is counted by its thread instead of being split
+constexpr int LEAF_TASK_DEPTH = 3;
+// separator between a root move and its node count
+constexpr auto DIVIDE_SEPARATOR = ": ";
+
+// ------------------- class implementation --------------------
+
+/**
+ * @brief a constructor for ParallelPerft
+ * @param root - the root position, which is copied
+ * @param depth - depth of the tree, in plies. assumes: depth is at least 1.
+ * @param threadNum - number of threads. assumes: threadNum is at least 1.
+ */
+ParallelPerft::ParallelPerft(const Board& root, int depth, int threadNum):
+        _root(root), _depth(depth), _threadNum(threadNum),
+        _rootNodes(new std::atomic<uint64_t>[MAX_MOVES]), _queues(new WorkQueue[threadNum]),
+        _pendingTasks(0)
+{
+    generateLegalMoves(_root, _rootMoves);
+    for (int i = 0; i < _rootMoves.size(); i++)
+    {
+        _rootNodes[i] = 0;
+        Task task;
+        task.path[0] = _rootMoves[i];
+        task.length = 1;
+        task.rootIndex = i;
+        task.depth = depth - 1;
+        _push(i % threadNum, task);
+    }
+}
+
+/**
+ * @brief adds a task to the given thread's deque
+ * @param thread - index of the thread
+ * @param task - the task to be added
+ */
+void ParallelPerft::_push(int thread, const Task& task)
+{
+    _pendingTasks++;
+    std::lock_guard<std::mutex> lock(_queues[thread].mutex);
+    _queues[thread].tasks.push_back(task);
+}
+
+/**
+ * @brief takes a task for the given thread: its newest own task, or else the oldest task of
+ * another thread.
+ * @param thread - index of the thread
+ * @param task - non-const ref, to which the function assigns the taken task
+ * @return true if a task was taken; false if all deques are empty
+ */
+bool ParallelPerft::_take(int thread, Task& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_queues[thread].mutex);
+        if (!_queues[thread].tasks.empty())
+        {
+            task = _queues[thread].tasks.back();
+            _queues[thread].tasks.pop_back();
+            return true;
+        }
+    }
+    for (int i = 1; i < _threadNum; i++)
+    {
+        WorkQueue& victim = _queues[(thread + i) % _threadNum];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief runs a task on the given thread's board: counts the subtree, or splits it into child
+ * tasks if it's deep enough.
+ * @param thread - index of the thread
+ * @param board - the thread's copy of the root position, left unchanged
+ * @param task - the task to be run
+ */
+void ParallelPerft::_run(int thread, Board& board, const Task& task)
+{
+    for (int i = 0; i < task.length; i++)
+    {
+        board.makeMove(task.path[i]);
+    }
+    if ((task.depth <= LEAF_TASK_DEPTH) || (task.length == MAX_TASK_PLY))
+    {
+        _rootNodes[task.rootIndex] += perft(board, task.depth);
+    }
+    else
+    {
+        MoveList moves;
+        generateLegalMoves(board, moves);
+        Task child = task;
+        child.length++;
+        child.depth--;
+        for (Move move: moves)
+        {
+            child.path[task.length] = move;
+            _push(thread, child);
+        }
+    }
+    board.undoMoves();
+}
+
+/**
+ * @brief the main loop of a thread: runs tasks until all of them are finished.
+ * @param thread - index of the thread
+ */
+void ParallelPerft::_work(int thread)
+{
+    Board board(_root);
+    Task task;
+    while (_pendingTasks > 0)
+    {
+        if (_take(thread, task))
+        {
+            _run(thread, board, task);
+            _pendingTasks--;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/**
+ * @brief counts the leaf nodes of the tree, and prints the count under every root move.
+ * @param out - stream to which the root moves and their counts are printed, one per line
+ * @return number of leaf nodes
+ */
+uint64_t ParallelPerft::run(std::ostream& out)
+{
+    vector<std::thread> threads;
+    for (int thread = 1; thread < _threadNum; thread++)
+    {
+        threads.emplace_back(&ParallelPerft::_work, this, thread);
+    }
+    _work(0);
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    uint64_t nodes = 0;
+    for (int i = 0; i < _rootMoves.size(); i++)
+    {
+        out << moveName(_rootMoves[i]) << DIVIDE_SEPARATOR << _rootNodes[i] << std::endl;
+        nodes += _rootNodes[i];
+    }
+    return nodes;
+}
\ No newline at end of file
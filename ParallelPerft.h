@@ -0,0 +1,107 @@
+// ParallelPerft.h
+
+#ifndef CHESS_CPP_PARALLELPERFT_H
+#define CHESS_CPP_PARALLELPERFT_H
+
+// ------------------------- includes --------------------------
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include "Perft.h"
+
+// --------------------- const definitions ---------------------
+
+// max number of moves from the root to the position of a perft task
+constexpr int MAX_TASK_PLY = 16;
+
+// --------------------- class declaration ---------------------
+
+/**
+ * This class represents a perft run split over several threads. the tree is split into subtree
+ * tasks, kept in a deque per thread: a thread takes its newest task, and once its deque is empty
+ * it steals the oldest (and so largest) task of another thread. a task that is still deep is split
+ * into its child subtrees instead of being counted, so the threads keep busy however uneven the
+ * subtree sizes are.
+ */
+class ParallelPerft
+{
+private:
+    /**
+     * a subtree of the perft tree
+     */
+    struct Task
+    {
+        Move path[MAX_TASK_PLY]; /** moves from the root to the subtree's position */
+        int length; /** number of moves in path */
+        int rootIndex; /** index of path[0] among the root moves */
+        int depth; /** remaining depth of the subtree, in plies */
+    };
+
+    /**
+     * the tasks of one thread, guarded by a mutex since other threads steal from it
+     */
+    struct WorkQueue
+    {
+        std::mutex mutex; /** guards tasks */
+        std::deque<Task> tasks; /** the thread's tasks, oldest first */
+    };
+
+    Board _root; /** the root position */
+    int _depth; /** depth of the tree, in plies */
+    int _threadNum; /** number of threads */
+    MoveList _rootMoves; /** legal moves of the root position */
+    std::unique_ptr<std::atomic<uint64_t>[]> _rootNodes; /** node counts, indexed like _rootMoves */
+    std::unique_ptr<WorkQueue[]> _queues; /** task deques, indexed by thread */
+    std::atomic<int> _pendingTasks; /** number of tasks pushed but not finished yet */
+
+    /**
+     * @brief adds a task to the given thread's deque
+     * @param thread - index of the thread
+     * @param task - the task to be added
+     */
+    void _push(int thread, const Task& task);
+
+    /**
+     * @brief takes a task for the given thread: its newest own task, or else the oldest task of
+     * another thread.
+     * @param thread - index of the thread
+     * @param task - non-const ref, to which the function assigns the taken task
+     * @return true if a task was taken; false if all deques are empty
+     */
+    bool _take(int thread, Task& task);
+
+    /**
+     * @brief runs a task on the given thread's board: counts the subtree, or splits it into child
+     * tasks if it's deep enough.
+     * @param thread - index of the thread
+     * @param board - the thread's copy of the root position, left unchanged
+     * @param task - the task to be run
+     */
+    void _run(int thread, Board& board, const Task& task);
+
+    /**
+     * @brief the main loop of a thread: runs tasks until all of them are finished.
+     * @param thread - index of the thread
+     */
+    void _work(int thread);
+
+public:
+    /**
+     * @brief a constructor for ParallelPerft
+     * @param root - the root position, which is copied
+     * @param depth - depth of the tree, in plies. assumes: depth is at least 1.
+     * @param threadNum - number of threads. assumes: threadNum is at least 1.
+     */
+    ParallelPerft(const Board& root, int depth, int threadNum);
+
+    /**
+     * @brief counts the leaf nodes of the tree, and prints the count under every root move.
+     * @param out - stream to which the root moves and their counts are printed, one per line
+     * @return number of leaf nodes
+     */
+    uint64_t run(std::ostream& out);
+};
+
+#endif //CHESS_CPP_PARALLELPERFT_H
\ No newline at end of file
@@ -0,0 +1,150 @@
+// PawnTable.cpp
+// This file contains the implementation of the class PawnTable
+
+// ------------------------- includes --------------------------
+
+#include "PawnTable.h"
+
+// --------------------- const definitions ---------------------
+
+// penalty of every pawn behind another of its color on the same file, indexed by GamePhase
+constexpr int DOUBLED_PENALTIES[PHASE_NUM] = {10, 25};
+// penalty of a pawn without pawns of its color on the adjacent files, indexed by GamePhase
+constexpr int ISOLATED_PENALTIES[PHASE_NUM] = {5, 15};
+// penalty of a pawn that no pawn of its color can defend and whose advance an enemy pawn stops,
+// indexed by GamePhase
+constexpr int BACKWARD_PENALTIES[PHASE_NUM] = {9, 12};
+// bonus of a passed pawn, indexed by GamePhase and the pawn's rank from its color's side
+constexpr int PASSED_BONUSES[PHASE_NUM][BOARD_SIZE] = {
+        {0, 5, 10, 15, 25, 45, 70, 0},
+        {0, 10, 15, 25, 45, 75, 120, 0}
+};
+
+/**
+ * the masks of the squares that decide the structure terms of a pawn
+ */
+struct PawnMasks
+{
+    /** squares ahead of a pawn on its own and adjacent files, indexed by colorIndex() and
+     * Square; a pawn is passed if no enemy pawn is on them */
+    Bitboard passedSpans[COLOR_NUM][BOARD_SQUARES];
+    /** squares level with or behind a pawn on the adjacent files, indexed by colorIndex() and
+     * Square; pawns of its color there can defend it, now or by advancing */
+    Bitboard supportSpans[COLOR_NUM][BOARD_SQUARES];
+    /** squares of the files adjacent to a file, indexed by file */
+    Bitboard adjacentFiles[BOARD_SIZE];
+};
+
+/**
+ * @brief generates the masks of all pawn structure terms at compile time
+ * @return the masks
+ */
+constexpr PawnMasks _createPawnMasks()
+{
+    PawnMasks masks = {};
+    for (int square = 0; square < BOARD_SQUARES; square++)
+    {
+        int file = fileOf(Square(square)), rank = rankOf(Square(square));
+        for (int other = 0; other < BOARD_SQUARES; other++)
+        {
+            int fileDistance = fileOf(Square(other)) - file;
+            int rankDistance = rankOf(Square(other)) - rank;
+            if ((fileDistance < -1) || (fileDistance > 1))
+            {
+                continue;
+            }
+            for (int color: {WHITE, BLACK})
+            {
+                Bitboard mask = squareMask(Square(other));
+                masks.passedSpans[colorIndex(color)][square] |=
+                        (rankDistance * color > 0 ? mask: EMPTY_BITBOARD);
+                bool isSupport = (fileDistance != 0) && (rankDistance * color <= 0);
+                masks.supportSpans[colorIndex(color)][square] |= (isSupport ? mask: EMPTY_BITBOARD);
+            }
+        }
+    }
+    for (int file = 0; file < BOARD_SIZE; file++)
+    {
+        Bitboard fileMask = FILE_A_MASK << file;
+        masks.adjacentFiles[file] = ((fileMask & ~FILE_A_MASK) >> 1) |
+                                    ((fileMask & ~FILE_H_MASK) << 1);
+    }
+    return masks;
+}
+
+// the masks of all pawn structure terms
+constexpr PawnMasks PAWN_MASKS = _createPawnMasks();
+
+// ------------------- class implementation --------------------
+
+/**
+ * @brief a constructor for PawnTable. the table is empty: every entry holds the structure without
+ * pawns, whose key is 0 and whose evaluation is empty.
+ */
+PawnTable::PawnTable(): _entries(new PawnEntry[PAWN_TABLE_ENTRIES])
+{
+}
+
+/**
+ * @brief evaluates the pawn structure of a position from scratch: doubled, isolated, backward and
+ * passed pawns.
+ * @param board - the position
+ * @param entry - non-const ref, to which the function assigns the evaluation
+ */
+void PawnTable::_evaluate(const Board& board, PawnEntry& entry)
+{
+    entry.key = board.getPawnKey();
+    entry.scores[MIDGAME] = entry.scores[ENDGAME] = 0;
+    entry.passed = EMPTY_BITBOARD;
+    for (int color: {WHITE, BLACK})
+    {
+        int index = colorIndex(color);
+        Bitboard ownPawns = board.getPieces(color, PAWN);
+        Bitboard enemyPawns = board.getPieces(color * REVERSE, PAWN);
+        Bitboard pawns = ownPawns;
+        while (pawns)
+        {
+            Square square = popLsb(pawns);
+            int file = fileOf(square);
+            int relativeRank = (color == WHITE ? rankOf(square): BOARD_SIZE - 1 - rankOf(square));
+            // only the pawns behind others are doubled, so that a pair counts once
+            bool isDoubled = (PAWN_MASKS.passedSpans[index][square] & ownPawns &
+                              (FILE_A_MASK << file)) != 0;
+            bool isIsolated = !(PAWN_MASKS.adjacentFiles[file] & ownPawns);
+            auto stop = Square(square + BOARD_SIZE * color);
+            bool isBackward = !isIsolated && !(PAWN_MASKS.supportSpans[index][square] & ownPawns) &&
+                              (pawnAttacks(color, stop) & enemyPawns);
+            // a pawn behind another of its color is never passed; the front one is
+            bool isPassed = !isDoubled && !(PAWN_MASKS.passedSpans[index][square] & enemyPawns);
+            entry.passed |= (isPassed ? squareMask(square): EMPTY_BITBOARD);
+            for (int phase = MIDGAME; phase < PHASE_NUM; phase++)
+            {
+                int score = (isPassed ? PASSED_BONUSES[phase][relativeRank]: 0) -
+                            (isDoubled ? DOUBLED_PENALTIES[phase]: 0) -
+                            (isIsolated ? ISOLATED_PENALTIES[phase]: 0) -
+                            (isBackward ? BACKWARD_PENALTIES[phase]: 0);
+                entry.scores[phase] += score * color;
+            }
+        }
+    }
+}
+
+/**
+ * @brief returns the evaluation of a position's pawn structure, from the table if it's there, or
+ * else evaluated and stored.
+ * @param board - the position
+ * @return the entry of the position's pawn structure, valid until the next probe
+ */
+const PawnEntry& PawnTable::probe(const Board& board)
+{
+    Key key = board.getPawnKey();
+    PawnEntry& entry = _entries[key & (PAWN_TABLE_ENTRIES - 1)];
+    _probes++;
+    if (entry.key == key)
+    {
+        _hits++;
+        return entry;
+    }
+    _evaluate(board, entry);
+    return entry;
+}
\ No newline at end of file
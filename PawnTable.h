@@ -0,0 +1,77 @@
+// PawnTable.h
+
+#ifndef CHESS_CPP_PAWNTABLE_H
+#define CHESS_CPP_PAWNTABLE_H
+
+// ------------------------- includes --------------------------
+
+#include <memory>
+#include "Board.h"
+
+// --------------------- const definitions ---------------------
+
+// number of entries in a pawn table. a power of two, so that a key maps to its entry by a mask.
+constexpr int PAWN_TABLE_ENTRIES = 1 << 13;
+
+// --------------------- struct declaration --------------------
+
+/**
+ * the evaluation of a pawn structure, as cached in a pawn table
+ */
+struct PawnEntry
+{
+    Key key = 0; /** pawn key of the structure */
+    int scores[PHASE_NUM] = {}; /** score of the structure in every phase, from white's view */
+    Bitboard passed = EMPTY_BITBOARD; /** the passed pawns of both colors */
+};
+
+// --------------------- class declaration ---------------------
+
+/**
+ * This class represents a pawn hash table: a small cache of pawn structure evaluations, keyed by
+ * the positions' pawn keys. pawn structures repeat across most nodes of a search, so most
+ * evaluations find theirs here. a pawn table isn't thread-safe; every search thread owns one.
+ */
+class PawnTable
+{
+private:
+    std::unique_ptr<PawnEntry[]> _entries; /** the entries, indexed by pawn key */
+    uint64_t _probes = 0; /** number of lookups */
+    uint64_t _hits = 0; /** number of lookups that found their structure */
+
+    /**
+     * @brief evaluates the pawn structure of a position from scratch: doubled, isolated, backward
+     * and passed pawns.
+     * @param board - the position
+     * @param entry - non-const ref, to which the function assigns the evaluation
+     */
+    static void _evaluate(const Board& board, PawnEntry& entry);
+
+public:
+    /**
+     * @brief a constructor for PawnTable. the table is empty.
+     */
+    PawnTable();
+
+    /**
+     * @brief returns the evaluation of a position's pawn structure, from the table if it's there,
+     * or else evaluated and stored.
+     * @param board - the position
+     * @return the entry of the position's pawn structure, valid until the next probe
+     */
+    const PawnEntry& probe(const Board& board);
+
+    /**
+     * @brief returns the number of lookups made
+     * @return number of calls to probe()
+     */
+    uint64_t getProbes() const {return _probes; }
+
+    /**
+     * @brief returns the number of lookups that found their structure in the table
+     * @return number of calls to probe() that didn't evaluate
+     */
+    uint64_t getHits() const {return _hits; }
+};
+
+#endif //CHESS_CPP_PAWNTABLE_H
\ No newline at end of file
@@ -0,0 +1,66 @@
+// Perft.cpp
+// This file contains the implementation of the perft node counters
+
+// ------------------------- includes --------------------------
+
+#include "Perft.h"
+
+// --------------------- const definitions ---------------------
+
+// separator between a root move and its node count
+constexpr auto DIVIDE_SEPARATOR = ": ";
+
+// ----------------- function implementation -------------------
+
+/**
+ * @brief counts the leaf nodes of the legal move tree to the given depth. the moves of the last
+ * ply are counted, not made.
+ * @param board - the root position. moves are made and unmade on it, so it is left unchanged.
+ * @param depth - depth of the tree, in plies
+ * @return number of leaf nodes
+ */
+uint64_t perft(Board& board, int depth)
+{
+    if (depth == 0)
+    {
+        return 1;
+    }
+    MoveList moves;
+    generateLegalMoves(board, moves);
+    if (depth == 1)
+    {
+        return moves.size();
+    }
+    uint64_t nodes = 0;
+    for (Move move: moves)
+    {
+        board.makeMove(move);
+        nodes += perft(board, depth - 1);
+        board.unmakeMove();
+    }
+    return nodes;
+}
+
+/**
+ * @brief counts the leaf nodes of the legal move tree to the given depth, and prints the count
+ * under every root move.
+ * @param board - the root position. moves are made and unmade on it, so it is left unchanged.
+ * @param depth - depth of the tree, in plies. assumes: depth is at least 1.
+ * @param out - stream to which the root moves and their counts are printed, one per line
+ * @return number of leaf nodes
+ */
+uint64_t perftDivide(Board& board, int depth, std::ostream& out)
+{
+    MoveList moves;
+    generateLegalMoves(board, moves);
+    uint64_t nodes = 0;
+    for (Move move: moves)
+    {
+        board.makeMove(move);
+        uint64_t moveNodes = perft(board, depth - 1);
+        board.unmakeMove();
+        out << moveName(move) << DIVIDE_SEPARATOR << moveNodes << std::endl;
+        nodes += moveNodes;
+    }
+    return nodes;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+// Perft.h
+
+#ifndef CHESS_CPP_PERFT_H
+#define CHESS_CPP_PERFT_H
+
+// ------------------------- includes --------------------------
+
+#include "MoveGen.h"
+
+// ------------------- function declarations -------------------
+
+/**
+ * @brief counts the leaf nodes of the legal move tree to the given depth. the moves of the last
+ * ply are counted, not made.
+ * @param board - the root position. moves are made and unmade on it, so it is left unchanged.
+ * @param depth - depth of the tree, in plies
+ * @return number of leaf nodes
+ */
+uint64_t perft(Board& board, int depth);
+
+/**
+ * @brief counts the leaf nodes of the legal move tree to the given depth, and prints the count
+ * under every root move.
+ * @param board - the root position. moves are made and unmade on it, so it is left unchanged.
+ * @param depth - depth of the tree, in plies. assumes: depth is at least 1.
+ * @param out - stream to which the root moves and their counts are printed, one per line
+ * @return number of leaf nodes
+ */
+uint64_t perftDivide(Board& board, int depth, std::ostream& out);
+
+#endif //CHESS_CPP_PERFT_H
\ No newline at end of file
@@ -3,50 +3,72 @@
 
 // ------------------------- includes --------------------------
 
-#include "Piece.h"
+#include "King.h"
+#include "Queen.h"
+#include "Rook.h"
+#include "Bishop.h"
+#include "Knight.h"
+#include "Pawn.h"
 
 // ------------------- class implementation --------------------
 
 /**
- * @brief change Piece's position on the board
- * @param position - a square on the board, e.g. "A1", representing Piece's new position on the
- * board
+ * @brief checks whether dest is in Piece's range of movement. e.g. if Piece is a rook and dest is
+ * diagonal to it, return false. dispatches by type to the static movement rules of the matching
+ * subclass.
+ * @param dest - a square on the board, e.g. A1
+ * @param isCapture - true if moving to dest captures an opponent's piece; false otherwise
+ * @return true if dest is in Piece's range of movement, false otherwise
  */
-void Piece::setPosition(const string& position)
+bool Piece::canReach(Square dest, bool isCapture) const
 {
-    _position = position;
-    _hasMoved = true;
+    switch (_type)
+    {
+        case PAWN:
+            return Pawn::reaches(_color, _position, dest, isCapture);
+        case KNIGHT:
+            return Knight::reaches(_color, _position, dest, isCapture);
+        case BISHOP:
+            return Bishop::reaches(_color, _position, dest, isCapture);
+        case ROOK:
+            return Rook::reaches(_color, _position, dest, isCapture);
+        case QUEEN:
+            return Queen::reaches(_color, _position, dest, isCapture);
+        default:
+            return King::reaches(_color, _position, dest, isCapture);
+    }
 }
 
 /**
- * @brief generates a path between Piece's position and dest, excluding position and dest; if Piece
- * can skip over other pieces, returns empty path. assumes: Piece.canReach(dest) = true. allocates
- * memory in freestore.
- * @param dest - a square on the board, e.g. "A1"
- * @return a vector of squares on the board, representing a path between Piece and dest.
+ * @brief returns the unicode character which prints Piece
+ * @return the unicode character matching Piece's type
  */
-vector<string>* Piece::getPathTo(const string& dest) const
-// default implementation shared by Queen, Bishop and Rook
+string Piece::print() const
 {
-    auto* newPath = new vector<string>;
-
-    char positionFile = _position[FILE_INDEX];
-    char destFile = dest[FILE_INDEX];
-    char positionRank = _position[RANK_INDEX];
-    char destRank = dest[RANK_INDEX];
-
-    int fileDirection = (positionFile < destFile) - (destFile < positionFile); //sgn function
-    int rankDirection = (positionRank < destRank) - (destRank < positionRank);
-    positionFile += fileDirection;
-    positionRank += rankDirection;
-
-    while ((positionFile != destFile) || (positionRank != destRank))
+    switch (_type)
     {
-        string squareFile = string(1, positionFile);
-        string squareRank = string(1, positionRank);
-        newPath->push_back(squareFile + squareRank);
-        positionFile += fileDirection;
-        positionRank += rankDirection;
+        case PAWN:
+            return PAWN_UNICODE;
+        case KNIGHT:
+            return KNIGHT_UNICODE;
+        case BISHOP:
+            return BISHOP_UNICODE;
+        case ROOK:
+            return ROOK_UNICODE;
+        case QUEEN:
+            return QUEEN_UNICODE;
+        default:
+            return KING_UNICODE;
     }
-    return newPath;
+}
+
+/**
+ * @brief returns the squares between Piece's position and dest, excluding position and dest; if
+ * Piece can skip over other pieces, returns no squares. assumes: Piece.canReach(dest) = true.
+ * @param dest - a square on the board, e.g. A1
+ * @return bitboard of the squares on the path between Piece and dest
+ */
+Bitboard Piece::getPathMask(Square dest) const
+{
+    return (_skips ? EMPTY_BITBOARD: betweenMask(_position, dest));
 }
\ No newline at end of file
@@ -5,12 +5,12 @@
 
 // ------------------------- includes --------------------------
 
+#include <new>
 #include <tuple>
-#include <vector>
 #include <iostream>
+#include "Square.h"
 
 using std::string;
-using std::vector;
 
 // --------------------- const definitions ---------------------
 
@@ -18,74 +18,92 @@ using std::vector;
 constexpr int WHITE = 1;
 // black set
 constexpr int BLACK = -1;
-// file's index in a position on the board, e.g. "A1"
-constexpr int FILE_INDEX = 0;
-// rank's index in a position on the board, e.g. "A1"
-constexpr int RANK_INDEX = 1;
+// reverse color
+constexpr int REVERSE = -1;
+// number of colors (sets) in a chess game
+constexpr int COLOR_NUM = 2;
+
+/**
+ * types of chess pieces, used as an index into per-type tables
+ */
+enum PieceType
+{
+    PAWN,
+    KNIGHT,
+    BISHOP,
+    ROOK,
+    QUEEN,
+    KING
+};
+
+// number of piece types
+constexpr int PIECE_TYPE_NUM = 6;
+// letters of the piece types in FEN and move notation, indexed by PieceType
+constexpr auto PIECE_LETTERS = "pnbrqk";
+
+/**
+ * @brief returns the index of the given color in per-color tables
+ * @param color - WHITE or BLACK
+ * @return 0 for WHITE, 1 for BLACK
+ */
+constexpr int colorIndex(int color) {return (color == WHITE ? 0: 1); }
 
 // --------------------- class declaration ---------------------
 
 /**
- * This class represents an abstract piece in a chess game.
+ * This class represents a piece in a chess game. Piece has no virtual functions: its behavior is
+ * selected by its type, and every subclass only adds a constructor and static movement rules.
  */
 class Piece
 {
 protected:
-    bool _hasMoved; /** true if Piece has been moved before; false otherwise */
     const int _color; /** color of Piece: WHITE or BLACK */
-    string _position; /** position of Piece on the board, e.g. "A1" */
+    Square _position; /** position of Piece on the board, e.g. A1 */
     const bool _skips; /** can Piece skip over other pieces when moving */
+    const PieceType _type; /** type of Piece, e.g. ROOK */
 public:
 
     /**
      * @brief a constructor for Piece
      * @param color - color of Piece: WHITE or BLACK
-     * @param position - initial position of Piece on the board, e.g. "A1"
+     * @param position - initial position of Piece on the board, e.g. A1
      * @param skips - can Piece skip over other pieces when moving
+     * @param type - type of Piece, e.g. ROOK
      */
-    Piece(int color, const string& position, bool skips):
-            _hasMoved(false), _color(color), _position(position), _skips(skips) {}
+    Piece(int color, Square position, bool skips, PieceType type):
+            _color(color), _position(position), _skips(skips), _type(type) {}
 
     /**
-     * @brief a destructor for Piece
-     */
-    virtual ~Piece() = default;
-
-    /**
-     * @brief creates a deep copy of Piece. allocates memory in freestore.
+     * @brief creates a deep copy of Piece in the given memory, e.g. a PiecePool slot.
+     * @param memory - uninitialized memory large enough for Piece
      * @return new clone of Piece
      */
-    virtual Piece* clone() = 0;
+    Piece* clone(void* memory) const {return new (memory) Piece(*this); }
 
     /**
      * @brief checks whether dest is in Piece's range of movement. e.g. if Piece is a rook and dest
-     * is diagonal to it, return false
-     * @param dest - a square on the board, e.g. "A1"
+     * is diagonal to it, return false. dispatches by type to the static movement rules of the
+     * matching subclass.
+     * @param dest - a square on the board, e.g. A1
      * @param isCapture - true if moving to dest captures an opponent's piece; false otherwise
      * @return true if dest is in Piece's range of movement, false otherwise
      */
-    virtual bool canReach(const string& dest, bool isCapture) const = 0;
+    bool canReach(Square dest, bool isCapture) const;
 
     /**
-     * @brief generates a path between Piece's position and dest, excluding position and dest; if
-     * Piece can skip over other pieces, returns empty path. assumes: Piece.canReach(dest) = true.
-     * allocates memory in freestore.
-     * @param dest - a square on the board, e.g. "A1"
-     * @return a vector of squares on the board, representing a path between Piece and dest.
+     * @brief returns the squares between Piece's position and dest, excluding position and dest;
+     * if Piece can skip over other pieces, returns no squares. assumes:
+     * Piece.canReach(dest) = true.
+     * @param dest - a square on the board, e.g. A1
+     * @return bitboard of the squares on the path between Piece and dest
      */
-    virtual vector<string>* getPathTo(const string& dest) const = 0;
+    Bitboard getPathMask(Square dest) const;
 
     /**
      * @brief returns the unicode character which prints Piece
      * @return the unicode character matching Piece's type
      */
-    virtual string print() const = 0;
-
-    /**
-     * @brief checks whether Piece has been moved before
-     * @return true if Piece has been moved already; false otherwise
-     */
-    bool hasMoved() const {return _hasMoved; }
+    string print() const;
 
     /**
      * @brief returns color of Piece
@@ -95,9 +113,9 @@ public:
 
     /**
      * @brief returns position of Piece on the board
-     * @return position of Piece on the board, e.g. "A1"
+     * @return position of Piece on the board, e.g. A1
      */
-    const string& getPosition() const {return _position; }
+    Square getPosition() const {return _position; }
 
     /**
      * @brief checks whether Piece can skip over other pieces when moving
@@ -105,24 +123,30 @@ public:
      */
     bool skips() const {return _skips; }
 
+    /**
+     * @brief returns type of Piece
+     * @return type of Piece, e.g. ROOK
+     */
+    PieceType getType() const {return _type; }
+
     /**
      * @brief change Piece's position on the board
-     * @param position - a square on the board, e.g. "A1", representing Piece's new position on the
+     * @param position - a square on the board, e.g. A1, representing Piece's new position on the
      * board
      */
-    void setPosition(const string& position); // also updates _hasMoved
+    void setPosition(Square position) {_position = position; }
 
     /**
      * @brief checks whether Piece is a king
      * return true if Piece is a king; false otherwise
      */
-    virtual bool isKing() const = 0;
+    bool isKing() const {return _type == KING; }
 
     /**
      * @brief checks whether Piece is a pawn
      * return true if Piece is a pawn; false otherwise
      */
-    virtual bool isPawn() const = 0;
+    bool isPawn() const {return _type == PAWN; }
 };
 
 #endif //CHESS_CPP_PIECE_H
\ No newline at end of file
@@ -0,0 +1,20 @@
+// PiecePool.cpp
+// This file contains the implementation of the class PiecePool
+
+// ------------------------- includes --------------------------
+
+#include "PiecePool.h"
+
+// ------------------- class implementation --------------------
+
+/**
+ * @brief a constructor for PiecePool. all slots are free.
+ */
+PiecePool::PiecePool(): _freeList(_slots)
+{
+    for (int i = 0; i < PIECE_POOL_SIZE - 1; i++)
+    {
+        _slots[i].next = &_slots[i + 1];
+    }
+    _slots[PIECE_POOL_SIZE - 1].next = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+// PiecePool.h
+
+#ifndef CHESS_CPP_PIECEPOOL_H
+#define CHESS_CPP_PIECEPOOL_H
+
+// ------------------------- includes --------------------------
+
+#include <type_traits>
+#include "Rook.h"
+#include "Bishop.h"
+#include "Queen.h"
+#include "Knight.h"
+#include "Pawn.h"
+#include "King.h"
+
+// --------------------- const definitions ---------------------
+
+// number of pieces a PiecePool holds: 32 pieces on the board, plus the pawns of up to 16
+// promotions that can still be unmade.
+constexpr int PIECE_POOL_SIZE = 48;
+
+static_assert(std::is_trivially_destructible<Piece>::value, "pieces are freed without destruction");
+
+// --------------------- class declaration ---------------------
+
+/**
+ * This class represents a fixed-capacity arena of pieces of any type, which keeps its free slots
+ * in a linked list. allocating or freeing a piece pops or pushes a slot, without touching the
+ * freestore.
+ */
+class PiecePool
+{
+private:
+    /**
+     * a slot holding one piece of any type, or the link to the next free slot
+     */
+    union Slot
+    {
+        Slot* next; /** next free slot; nullptr if this is the last one */
+        std::aligned_union_t<0, Pawn, Knight, Bishop, Rook, Queen, King> storage; /** a piece */
+    };
+
+    Slot _slots[PIECE_POOL_SIZE]; /** the slots */
+    Slot* _freeList; /** first free slot; nullptr if all slots are in use */
+
+public:
+    /**
+     * @brief a constructor for PiecePool. all slots are free.
+     */
+    PiecePool();
+
+    /**
+     * @brief PiecePool can't be copied, as pieces point into it.
+     */
+    PiecePool(const PiecePool&) = delete;
+
+    /**
+     * @brief PiecePool can't be assigned, as pieces point into it.
+     */
+    PiecePool& operator=(const PiecePool&) = delete;
+
+    /**
+     * @brief returns the memory of a free slot, in which a piece is to be constructed. assumes:
+     * PiecePool has a free slot.
+     * @return memory for one piece of any type
+     */
+    void* allocate()
+    {
+        Slot* slot = _freeList;
+        _freeList = slot->next;
+        return slot;
+    }
+
+    /**
+     * @brief frees the slot of a piece allocated from PiecePool. pieces are trivially
+     * destructible, so nothing has to be destroyed.
+     * @param piece - the piece to be freed; nullptr to do nothing
+     */
+    void free(Piece* piece)
+    {
+        if (piece == nullptr)
+        {
+            return;
+        }
+        auto* slot = reinterpret_cast<Slot*>(piece);
+        slot->next = _freeList;
+        _freeList = slot;
+    }
+};
+
+#endif //CHESS_CPP_PIECEPOOL_H
\ No newline at end of file
@@ -0,0 +1,570 @@
+// Search.cpp
+// This file contains the implementation of the class Search
+
+// ------------------------- includes --------------------------
+
+#include <climits>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include "Search.h"
+
+using std::vector;
+
+// --------------------- const definitions ---------------------
+
+// milliseconds in a second
+constexpr uint64_t MILLISECONDS = 1000;
+// permille of a whole
+constexpr uint64_t PERMILLE = 1000;
+// the effective branching factor is printed to this many decimal places
+constexpr double EBF_PRECISION = 100;
+
+// ------------------- class implementation --------------------
+
+/**
+ * @brief a constructor for Search
+ * @param root - the position to be searched, which is copied
+ * @param limits - the budget of the search
+ * @param table - the transposition table, which may be shared with other searches
+ * @param shared - the state shared by the threads of the search
+ * @param threadIndex - index of the thread running Search; 0 for the main thread
+ */
+Search::Search(const Board& root, const SearchLimits& limits, TranspositionTable& table,
+               SharedSearchState& shared, int threadIndex):
+        _board(root), _limits(limits), _table(table), _shared(shared), _threadIndex(threadIndex)
+{
+    if (getNetwork() != nullptr)
+    {
+        _nnue = std::make_unique<NnueEvaluator>(*getNetwork());
+    }
+}
+
+/**
+ * @brief makes a move on the searched position, and pushes its accumulator if a network is loaded
+ * @param move - the move. assumes: move is pseudo-legal.
+ */
+void Search::_makeMove(Move move)
+{
+    if (_nnue)
+    {
+        _nnue->push(_board, move);
+    }
+    _board.makeMove(move);
+}
+
+/**
+ * @brief makes a null move on the searched position, and pushes its accumulator if a network is
+ * loaded
+ */
+void Search::_makeNullMove()
+{
+    if (_nnue)
+    {
+        _nnue->pushNull();
+    }
+    _board.makeNullMove();
+}
+
+/**
+ * @brief unmakes the latest move or null move on the searched position, and pops its accumulator
+ * if a network is loaded
+ */
+void Search::_unmakeMove()
+{
+    if (_nnue)
+    {
+        _nnue->pop();
+    }
+    _board.unmakeMove();
+}
+
+/**
+ * @brief evaluates the searched position: with the loaded network, or else by hand
+ * @return score of the position in centipawns, from the point of view of the player to move,
+ * within the mate bounds
+ */
+int Search::_evaluate()
+{
+    if (!_nnue)
+    {
+        return evaluate(_board, _pawnTable);
+    }
+    // the network's output isn't bounded, and mustn't be mistaken for a mate
+    return std::max(-MATE_BOUND + 1, std::min(_nnue->evaluate(_board), MATE_BOUND - 1));
+}
+
+/**
+ * @brief returns the time elapsed since the search started
+ * @return elapsed time, in milliseconds
+ */
+uint64_t Search::_elapsed() const
+{
+    auto elapsed = std::chrono::steady_clock::now() - _start;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+}
+
+/**
+ * @brief counts a visited node, and checks every few nodes whether the search is stopped: by the
+ * main thread, or for the main thread by reaching a limit.
+ * @return true if the search is stopped; false otherwise
+ */
+bool Search::_checkLimits()
+{
+    _nodes++;
+    bool isCheckTime = ((_nodes & CHECK_INTERVAL_MASK) == 0);
+    if (isCheckTime)
+    {
+        _shared.nodes.fetch_add(CHECK_INTERVAL, std::memory_order_relaxed);
+    }
+    if (_shared.isStopped.load(std::memory_order_relaxed))
+    {
+        _isStopped = true;
+    }
+    else if (_threadIndex == 0)
+    {
+        uint64_t nodes = _shared.nodes.load(std::memory_order_relaxed) +
+                         (_nodes & CHECK_INTERVAL_MASK);
+        _isStopped = ((_limits.nodes != 0) && (nodes >= _limits.nodes)) ||
+                     ((_limits.milliseconds != 0) && isCheckTime &&
+                      (_elapsed() >= _limits.milliseconds));
+    }
+    return _isStopped;
+}
+
+/**
+ * @brief converts a score to be stored in the transposition table: mate scores count the plies to
+ * the mate from the stored position instead of from the root.
+ * @param score - score of a position, relative to the root
+ * @param ply - distance of the position from the root, in plies
+ * @return score of the position, relative to the position
+ */
+static int _scoreToTable(int score, int ply)
+{
+    return (score > MATE_BOUND ? score + ply: (score < -MATE_BOUND ? score - ply: score));
+}
+
+/**
+ * @brief converts a score read from the transposition table back to a score relative to the root
+ * @param score - score of a position, relative to the position
+ * @param ply - distance of the position from the root, in plies
+ * @return score of the position, relative to the root
+ */
+static int _scoreFromTable(int score, int ply)
+{
+    return (score > MATE_BOUND ? score - ply: (score < -MATE_BOUND ? score + ply: score));
+}
+
+/**
+ * @brief stores the result of searching the current position in the transposition table
+ * @param key - Zobrist key of the position
+ * @param move - best move found; a null move if none
+ * @param score - score of the position, relative to the root
+ * @param depth - depth of the search, in plies
+ * @param bound - relation of score to the position's true score
+ * @param ply - distance of the position from the root, in plies
+ */
+void Search::_store(Key key, Move move, int score, int depth, Bound bound, int ply)
+{
+    TableEntry entry;
+    entry.move = move;
+    entry.score = _scoreToTable(score, ply);
+    entry.depth = depth;
+    entry.bound = bound;
+    _table.store(key, entry);
+}
+
+/**
+ * @brief records a quiet move that failed high: makes it the first killer move of its ply, and
+ * raises its history score by the square of the depth.
+ * @param move - the quiet move
+ * @param depth - remaining depth at which it failed high, in plies
+ * @param ply - distance from the root, in plies
+ */
+void Search::_updateQuietStats(Move move, int depth, int ply)
+{
+    Move* killers = _killers[ply];
+    if (killers[0] != move)
+    {
+        killers[1] = killers[0];
+        killers[0] = move;
+    }
+    auto& history = _history[colorIndex(_board.getSideToMove())];
+    int& score = history[move.getSrc()][move.getDest()];
+    score += depth * depth;
+    if (score > HISTORY_LIMIT)
+    {
+        for (auto& fromSquare: history)
+        {
+            for (int& toScore: fromSquare)
+            {
+                toScore /= 2;
+            }
+        }
+    }
+}
+
+/**
+ * @brief returns the floor of the binary logarithm of a number
+ * @param number - a positive number
+ * @return the index of number's highest set bit
+ */
+static int _log2(int number)
+{
+    return int(sizeof(unsigned) * CHAR_BIT) - 1 - __builtin_clz(unsigned(number));
+}
+
+/**
+ * @brief returns the depth reduction of a late quiet move: larger the deeper the node and the later
+ * the move, and smaller the better its history score.
+ * @param depth - remaining depth of the node, in plies
+ * @param moveNum - number of the move in the order of MovePicker, counting from 1
+ * @param move - the move
+ * @param color - color of the player making the move: WHITE or BLACK
+ * @return the reduction, in plies; at least 0, and leaving at least 1 ply to search
+ */
+int Search::_lateMoveReduction(int depth, int moveNum, Move move, int color) const
+{
+    int history = _history[colorIndex(color)][move.getSrc()][move.getDest()];
+    int reduction = 1 + _log2(depth) * _log2(moveNum) / LMR_DIVISOR - history / LMR_HISTORY_DIVISOR;
+    return std::max(0, std::min(reduction, depth - 2));
+}
+
+/**
+ * @brief searches the captures and promotions of the current position until it's quiet, so that a
+ * position isn't evaluated in the middle of an exchange. the player to move may stand pat on the
+ * static evaluation, and captures that lose material by static exchange evaluation are skipped.
+ * @param ply - distance from the root, in plies
+ * @param alpha - score the player to move is already assured of
+ * @param beta - score the opponent is already assured of
+ * @return score of the position, from the point of view of the player to move, bounded by alpha
+ * and beta; meaningless if the search was stopped
+ */
+int Search::_quiescence(int ply, int alpha, int beta)
+{
+    _pvLength[ply] = 0;
+    if (_checkLimits())
+    {
+        return DRAW_SCORE;
+    }
+    if (ply == MAX_PLY - 1)
+    {
+        return std::max(alpha, std::min(_evaluate(), beta));
+    }
+    // a player in check can't stand pat, and must try all evasions
+    bool isInCheck = _board.isInCheck(_board.getSideToMove());
+    if (!isInCheck)
+    {
+        int standPat = _evaluate();
+        if (standPat >= beta)
+        {
+            return beta;
+        }
+        alpha = std::max(alpha, standPat);
+    }
+
+    MovePicker picker = (isInCheck ? MovePicker(_board, Move(), _killers[ply], _history):
+                         MovePicker(_board));
+    int moveNum = 0;
+    for (Move move = picker.next(); !move.isNull(); move = picker.next())
+    {
+        moveNum++;
+        _makeMove(move);
+        int score = -_quiescence(ply + 1, -beta, -alpha);
+        _unmakeMove();
+        if (_isStopped)
+        {
+            return DRAW_SCORE;
+        }
+        if (score >= beta)
+        {
+            return beta;
+        }
+        alpha = std::max(alpha, score);
+    }
+    if (isInCheck && (moveNum == 0))
+    {
+        return std::max(alpha, -MATE_SCORE + ply);
+    }
+    return alpha;
+}
+
+/**
+ * @brief searches the current position with a fail-hard negamax alpha-beta search, and records its
+ * principal variation. moves are tried in the order of MovePicker, with the previous iteration's
+ * principal variation, or else the transposition table's move, first; the moves after the first
+ * are searched with a null window, and again with the full one if they turn out to beat alpha. the
+ * enabled techniques of SearchLimits::pruning cut or reduce the nodes that are unlikely to matter.
+ * @param depth - remaining depth, in plies
+ * @param ply - distance from the root, in plies
+ * @param alpha - score the player to move is already assured of
+ * @param beta - score the opponent is already assured of
+ * @param isNullMoveAllowed - false right after a null move, so that two aren't made in a row
+ * @return score of the position, from the point of view of the player to move, bounded by alpha
+ * and beta; meaningless if the search was stopped
+ */
+int Search::_negamax(int depth, int ply, int alpha, int beta, bool isNullMoveAllowed)
+{
+    if (depth <= 0)
+    {
+        return _quiescence(ply, alpha, beta);
+    }
+    _pvLength[ply] = 0;
+    if (_checkLimits())
+    {
+        return DRAW_SCORE;
+    }
+    if (ply == MAX_PLY - 1)
+    {
+        return _evaluate();
+    }
+
+    Key key = _board.getKey();
+    TableEntry entry;
+    _tableProbes++;
+    if (_table.probe(key, entry))
+    {
+        _tableHits++;
+        int score = _scoreFromTable(entry.score, ply);
+        if ((ply > 0) && (entry.depth >= depth) &&
+            ((entry.bound == EXACT_BOUND) || ((entry.bound == LOWER_BOUND) && (score >= beta)) ||
+             ((entry.bound == UPPER_BOUND) && (score <= alpha))))
+        {
+            return std::max(alpha, std::min(score, beta));
+        }
+    }
+
+    int color = _board.getSideToMove();
+    bool isInCheck = _board.isInCheck(color);
+    // a node searched with a null window only decides whether its score beats alpha
+    bool isPvNode = (beta - alpha > 1);
+    bool canPrune = !isPvNode && !isInCheck && (std::abs(beta) < MATE_BOUND);
+    int staticScore = (canPrune ? _evaluate(): DRAW_SCORE);
+
+    // reverse futility pruning: near the leaves, a position far above beta stays above it
+    if (canPrune && (_limits.pruning & FUTILITY_PRUNING) && (depth <= FUTILITY_DEPTH) &&
+        (staticScore - FUTILITY_MARGIN * depth >= beta))
+    {
+        return beta;
+    }
+
+    // null move pruning: if passing still fails high, a move surely would. not tried without
+    // pieces, where passing may be the best move (zugzwang)
+    Bitboard pieces = _board.getOccupancy(color) & ~_board.getPieces(color, PAWN) &
+                      ~_board.getPieces(color, KING);
+    if (canPrune && (_limits.pruning & NULL_MOVE_PRUNING) && isNullMoveAllowed &&
+        (depth >= NULL_MOVE_MIN_DEPTH) && (staticScore >= beta) && pieces)
+    {
+        int reduction = NULL_MOVE_REDUCTION + depth / NULL_MOVE_DEPTH_DIVISOR;
+        _makeNullMove();
+        int score = -_negamax(depth - 1 - reduction, ply + 1, -beta, -beta + 1, false);
+        _unmakeMove();
+        if (_isStopped)
+        {
+            return DRAW_SCORE;
+        }
+        if (score >= beta)
+        {
+            return beta;
+        }
+    }
+
+    // futility pruning: near the leaves, quiet moves can't lift a position far below alpha
+    bool isFutile = canPrune && (_limits.pruning & FUTILITY_PRUNING) &&
+                    (depth <= FUTILITY_DEPTH) && (staticScore + FUTILITY_MARGIN * depth <= alpha);
+
+    Move pvMove = ((_isFollowingPv && (ply < _previousPvLength)) ? _previousPv[ply]: Move());
+    MovePicker picker(_board, (pvMove.isNull() ? entry.move: pvMove), _killers[ply], _history);
+    int oldAlpha = alpha;
+    Move bestMove;
+    int moveNum = 0;
+    for (Move move = picker.next(); !move.isNull(); move = picker.next())
+    {
+        // only the first child of a node on the previous principal variation is on it as well
+        _isFollowingPv = _isFollowingPv && (move == pvMove);
+        moveNum++;
+        bool isQuiet = !move.isCapture() && !move.isPromotion();
+        _makeMove(move);
+        bool givesCheck = _board.isInCheck(color * REVERSE);
+        if (isFutile && isQuiet && !givesCheck && (moveNum > 1))
+        {
+            _unmakeMove();
+            continue;
+        }
+        int score;
+        if (moveNum == 1)
+        {
+            score = -_negamax(depth - 1, ply + 1, -beta, -alpha);
+        }
+        else
+        {
+            // the later moves are expected to fail low: they're searched with a null window,
+            // and the quiet ones among them less deep, and searched again if they don't
+            int reduction = 0;
+            if ((_limits.pruning & LATE_MOVE_REDUCTIONS) && (depth >= LMR_MIN_DEPTH) &&
+                (moveNum >= LMR_MIN_MOVE_NUM) && isQuiet && !isInCheck && !givesCheck &&
+                (move != _killers[ply][0]) && (move != _killers[ply][1]))
+            {
+                reduction = _lateMoveReduction(depth, moveNum, move, color);
+            }
+            score = -_negamax(depth - 1 - reduction, ply + 1, -alpha - 1, -alpha);
+            if ((score > alpha) && (reduction > 0) && !_isStopped)
+            {
+                score = -_negamax(depth - 1, ply + 1, -alpha - 1, -alpha);
+            }
+            if ((score > alpha) && (score < beta) && !_isStopped)
+            {
+                score = -_negamax(depth - 1, ply + 1, -beta, -alpha);
+            }
+        }
+        _unmakeMove();
+        _isFollowingPv = false;
+        if (_isStopped)
+        {
+            return DRAW_SCORE;
+        }
+        if (score >= beta)
+        {
+            _cutoffs++;
+            _firstMoveCutoffs += (moveNum == 1);
+            if (isQuiet)
+            {
+                _updateQuietStats(move, depth, ply);
+            }
+            _store(key, move, beta, depth, LOWER_BOUND, ply);
+            return beta;
+        }
+        if (score > alpha)
+        {
+            alpha = score;
+            bestMove = move;
+            _pv[ply][0] = move;
+            std::copy(_pv[ply + 1], _pv[ply + 1] + _pvLength[ply + 1], _pv[ply] + 1);
+            _pvLength[ply] = _pvLength[ply + 1] + 1;
+        }
+    }
+    if (moveNum == 0)
+    {
+        return (isInCheck ? -MATE_SCORE + ply: DRAW_SCORE);
+    }
+    _store(key, bestMove, alpha, depth, (alpha > oldAlpha ? EXACT_BOUND: UPPER_BOUND), ply);
+    return alpha;
+}
+
+/**
+ * @brief runs the iterative deepening until it's stopped. the main thread prints the score, node
+ * count of all threads, speed, table hit rates, effective branching factor (the ratio of the
+ * nodes of an iteration to those of the previous one), first-move cutoff rate and principal
+ * variation of every completed iteration.
+ * @param out - stream to which every iteration is reported, one line per iteration
+ * @return the result of the last completed iteration
+ */
+SearchResult Search::run(std::ostream& out)
+{
+    _start = std::chrono::steady_clock::now();
+    SearchResult result;
+    MoveList rootMoves;
+    generateLegalMoves(_board, rootMoves);
+    if (rootMoves.size() == 0)
+    {
+        return result;
+    }
+    result.bestMove = rootMoves[0];
+    if (_nnue)
+    {
+        _nnue->reset(_board);
+    }
+
+    uint64_t previousIterationNodes = 0;
+    for (int depth = 1 + _threadIndex % 2; depth <= std::min(_limits.depth, MAX_PLY - 1); depth++)
+    {
+        uint64_t iterationStartNodes = _nodes;
+        _isFollowingPv = true;
+        int score = _negamax(depth, 0, -INFINITE_SCORE, INFINITE_SCORE);
+        if (_isStopped)
+        {
+            break;
+        }
+        result.score = score;
+        result.depth = depth;
+        result.pvLength = _pvLength[0];
+        std::copy(_pv[0], _pv[0] + _pvLength[0], result.pv);
+        std::copy(_pv[0], _pv[0] + _pvLength[0], _previousPv);
+        _previousPvLength = _pvLength[0];
+        result.bestMove = result.pv[0];
+
+        if (_threadIndex != 0)
+        {
+            continue;
+        }
+        uint64_t milliseconds = _elapsed();
+        uint64_t nodes = _shared.nodes.load(std::memory_order_relaxed) +
+                         (_nodes & CHECK_INTERVAL_MASK);
+        uint64_t nodesPerSecond = nodes * MILLISECONDS / std::max<uint64_t>(milliseconds, 1);
+        uint64_t iterationNodes = _nodes - iterationStartNodes;
+        double branchingFactor = double(iterationNodes) /
+                                 std::max<uint64_t>(previousIterationNodes, 1);
+        previousIterationNodes = iterationNodes;
+        out << "depth " << depth << " score " << score << " nodes " << nodes << " time "
+            << milliseconds << " ms nps " << nodesPerSecond << " hashhit "
+            << _tableHits * PERMILLE / std::max<uint64_t>(_tableProbes, 1) << " hashfull "
+            << _table.fillRate() << " pawnhit "
+            << _pawnTable.getHits() * PERMILLE / std::max<uint64_t>(_pawnTable.getProbes(), 1)
+            << " ebf "
+            << std::round(branchingFactor * EBF_PRECISION) / EBF_PRECISION << " fmc "
+            << _firstMoveCutoffs * PERMILLE / std::max<uint64_t>(_cutoffs, 1) << " pv";
+        for (int i = 0; i < result.pvLength; i++)
+        {
+            out << " " << moveName(result.pv[i]);
+        }
+        out << std::endl;
+        if (std::abs(score) > MATE_BOUND)
+        {
+            break;
+        }
+    }
+    _shared.nodes.fetch_add(_nodes & CHECK_INTERVAL_MASK, std::memory_order_relaxed);
+    result.nodes = _nodes;
+    result.milliseconds = _elapsed();
+    result.tableProbes = _tableProbes;
+    result.tableHits = _tableHits;
+    result.pawnProbes = _pawnTable.getProbes();
+    result.pawnHits = _pawnTable.getHits();
+    result.cutoffs = _cutoffs;
+    result.firstMoveCutoffs = _firstMoveCutoffs;
+    return result;
+}
+
+// ----------------- function implementation -------------------
+
+/**
+ * @brief searches a position for the best move within the given limits.
+ * @param position - the position
+ * @param limits - the budget of the search
+ * @param table - the transposition table, kept between searches
+ * @param out - stream to which every iteration is reported, one line per iteration
+ * @param threadNum - number of threads searching in parallel. assumes: threadNum is at least 1.
+ * @return the best move and the line, score and statistics of the search; the node count covers
+ * all threads
+ */
+SearchResult bestMove(const Board& position, const SearchLimits& limits, TranspositionTable& table,
+                      std::ostream& out, int threadNum)
+{
+    table.newSearch();
+    SharedSearchState shared;
+    vector<std::unique_ptr<Search>> helpers;
+    vector<std::thread> threads;
+    for (int thread = 1; thread < threadNum; thread++)
+    {
+        helpers.emplace_back(new Search(position, limits, table, shared, thread));
+        threads.emplace_back(&Search::run, helpers.back().get(), std::ref(out));
+    }
+    SearchResult result = Search(position, limits, table, shared, 0).run(out);
+    shared.isStopped = true;
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+    result.nodes = shared.nodes;
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,279 @@
+// Search.h
+
+#ifndef CHESS_CPP_SEARCH_H
+#define CHESS_CPP_SEARCH_H
+
+// ------------------------- includes --------------------------
+
+#include <atomic>
+#include <chrono>
+#include "MovePicker.h"
+#include "Nnue.h"
+#include "TranspositionTable.h"
+
+// --------------------- const definitions ---------------------
+
+// max number of plies from the root that a search reaches
+constexpr int MAX_PLY = 64;
+// score of being checkmated at the root; mates further away score closer to 0
+constexpr int MATE_SCORE = 32000;
+// a bound beyond every score
+constexpr int INFINITE_SCORE = MATE_SCORE + 1;
+// scores beyond this bound are mates within MAX_PLY plies
+constexpr int MATE_BOUND = MATE_SCORE - MAX_PLY;
+// score of a drawn position
+constexpr int DRAW_SCORE = 0;
+
+/**
+ * the selective pruning techniques of a search, which can be combined as flags
+ */
+enum Pruning
+{
+    NO_PRUNING = 0, /** every move is searched to the full depth */
+    NULL_MOVE_PRUNING = 1, /** a node fails high if passing the turn fails high */
+    LATE_MOVE_REDUCTIONS = 2, /** late quiet moves are searched less deep */
+    FUTILITY_PRUNING = 4, /** near the leaves, nodes far from the window are cut */
+    ALL_PRUNING = NULL_MOVE_PRUNING | LATE_MOVE_REDUCTIONS | FUTILITY_PRUNING /** all of them */
+};
+
+// --------------------- struct declaration --------------------
+
+/**
+ * the budget of a search. the search stops at whichever limit it reaches first.
+ */
+struct SearchLimits
+{
+    int depth = MAX_PLY - 1; /** max depth of the iterative deepening, in plies */
+    uint64_t nodes = 0; /** max number of visited nodes; 0 for no limit */
+    uint64_t milliseconds = 0; /** max search time; 0 for no limit */
+    int pruning = ALL_PRUNING; /** the Pruning techniques enabled, e.g. NULL_MOVE_PRUNING */
+};
+
+/**
+ * the outcome of a search: the result of its last completed iteration
+ */
+struct SearchResult
+{
+    Move bestMove; /** the move to play; a null move if the root has no legal move */
+    int score = 0; /** score of bestMove in centipawns, from the point of view of the root player */
+    int depth = 0; /** depth of the last completed iteration, in plies */
+    uint64_t nodes = 0; /** number of nodes visited by all iterations */
+    uint64_t milliseconds = 0; /** time taken by all iterations */
+    Move pv[MAX_PLY]; /** the principal variation, i.e. the expected line of play from the root */
+    int pvLength = 0; /** number of moves in pv */
+    uint64_t tableProbes = 0; /** number of transposition table lookups */
+    uint64_t tableHits = 0; /** number of transposition table lookups that found their position */
+    uint64_t pawnProbes = 0; /** number of pawn table lookups */
+    uint64_t pawnHits = 0; /** number of pawn table lookups that found their pawn structure */
+    uint64_t cutoffs = 0; /** number of nodes that failed high */
+    uint64_t firstMoveCutoffs = 0; /** number of those nodes that failed high on their first move */
+};
+
+/**
+ * the state shared by the threads of a parallel search
+ */
+struct SharedSearchState
+{
+    std::atomic<bool> isStopped{false}; /** set once the main thread has finished its search */
+    std::atomic<uint64_t> nodes{0}; /** nodes visited by all threads, added in batches */
+};
+
+// --------------------- class declaration ---------------------
+
+/**
+ * This class represents a search for the best move of a position: a negamax alpha-beta search,
+ * deepened iteratively until a limit of SearchLimits is reached. a parallel search runs one Search
+ * per thread on the same root, sharing the transposition table (Lazy SMP): the main thread checks
+ * the limits, reports its iterations and stops the others; the helper threads only fill the table
+ * with results that the main thread then finds, and half of them search one ply deeper to spread
+ * the work over different depths.
+ */
+class Search
+{
+private:
+    // number of nodes between two checks of the time limit, minus 1
+    static constexpr uint64_t CHECK_INTERVAL_MASK = 1023;
+    // number of nodes between two checks of the time limit
+    static constexpr uint64_t CHECK_INTERVAL = CHECK_INTERVAL_MASK + 1;
+    // history scores are halved once one of them passes this limit, so that they don't overflow
+    static constexpr int HISTORY_LIMIT = 1 << 20;
+    // max remaining depth of futility pruning, in plies
+    static constexpr int FUTILITY_DEPTH = 3;
+    // margin of futility pruning per ply of remaining depth, in centipawns
+    static constexpr int FUTILITY_MARGIN = 120;
+    // min remaining depth of null move pruning, in plies
+    static constexpr int NULL_MOVE_MIN_DEPTH = 3;
+    // depth reduction of a null move, in plies, besides the ply of the move itself
+    static constexpr int NULL_MOVE_REDUCTION = 2;
+    // a null move is reduced by one more ply for every this many plies of remaining depth
+    static constexpr int NULL_MOVE_DEPTH_DIVISOR = 6;
+    // min remaining depth of late move reductions, in plies
+    static constexpr int LMR_MIN_DEPTH = 3;
+    // a move is reduced from this number on, counting from 1 in the order of MovePicker
+    static constexpr int LMR_MIN_MOVE_NUM = 4;
+    // a late move is reduced by the product of the logarithms of the depth and its number,
+    // divided by this
+    static constexpr int LMR_DIVISOR = 5;
+    // a late move is reduced by one ply less for every this many points of its history score
+    static constexpr int LMR_HISTORY_DIVISOR = 8192;
+
+    Board _board; /** the position searched, copied from the root */
+    SearchLimits _limits; /** the budget of the search */
+    TranspositionTable& _table; /** the transposition table */
+    PawnTable _pawnTable; /** the pawn table, owned by the thread */
+    std::unique_ptr<NnueEvaluator> _nnue; /** the network's evaluator; nullptr if none is loaded */
+    SharedSearchState& _shared; /** the state shared with the other threads of the search */
+    int _threadIndex; /** index of the thread running Search; 0 for the main thread */
+    std::chrono::steady_clock::time_point _start; /** time at which the search started */
+    uint64_t _nodes = 0; /** number of nodes visited so far */
+    uint64_t _tableProbes = 0; /** number of transposition table lookups so far */
+    uint64_t _tableHits = 0; /** number of those lookups that found their position */
+    bool _isStopped = false; /** true once a limit is reached; the current iteration is dropped */
+    Move _pv[MAX_PLY][MAX_PLY]; /** principal variation found from every ply, indexed by ply */
+    int _pvLength[MAX_PLY] = {}; /** number of moves in the variation of every ply */
+    Move _previousPv[MAX_PLY]; /** principal variation of the last completed iteration */
+    int _previousPvLength = 0; /** number of moves in _previousPv */
+    bool _isFollowingPv = false; /** true while the search walks down _previousPv */
+    Move _killers[MAX_PLY][KILLER_NUM]; /** quiet moves that recently failed high, per ply */
+    HistoryTable _history = {}; /** history scores of quiet moves */
+    uint64_t _cutoffs = 0; /** number of nodes that failed high so far */
+    uint64_t _firstMoveCutoffs = 0; /** number of those that failed high on their first move */
+
+    /**
+     * @brief makes a move on the searched position, and pushes its accumulator if a network is
+     * loaded
+     * @param move - the move. assumes: move is pseudo-legal.
+     */
+    void _makeMove(Move move);
+
+    /**
+     * @brief makes a null move on the searched position, and pushes its accumulator if a network
+     * is loaded
+     */
+    void _makeNullMove();
+
+    /**
+     * @brief unmakes the latest move or null move on the searched position, and pops its
+     * accumulator if a network is loaded
+     */
+    void _unmakeMove();
+
+    /**
+     * @brief evaluates the searched position: with the loaded network, or else by hand
+     * @return score of the position in centipawns, from the point of view of the player to move,
+     * within the mate bounds
+     */
+    int _evaluate();
+
+    /**
+     * @brief returns the time elapsed since the search started
+     * @return elapsed time, in milliseconds
+     */
+    uint64_t _elapsed() const;
+
+    /**
+     * @brief counts a visited node, and checks every few nodes whether the search is stopped:
+     * by the main thread, or for the main thread by reaching a limit.
+     * @return true if the search is stopped; false otherwise
+     */
+    bool _checkLimits();
+
+    /**
+     * @brief stores the result of searching the current position in the transposition table
+     * @param key - Zobrist key of the position
+     * @param move - best move found; a null move if none
+     * @param score - score of the position, relative to the root
+     * @param depth - depth of the search, in plies
+     * @param bound - relation of score to the position's true score
+     * @param ply - distance of the position from the root, in plies
+     */
+    void _store(Key key, Move move, int score, int depth, Bound bound, int ply);
+
+    /**
+     * @brief records a quiet move that failed high: makes it the first killer move of its ply,
+     * and raises its history score by the square of the depth.
+     * @param move - the quiet move
+     * @param depth - remaining depth at which it failed high, in plies
+     * @param ply - distance from the root, in plies
+     */
+    void _updateQuietStats(Move move, int depth, int ply);
+
+    /**
+     * @brief returns the depth reduction of a late quiet move: larger the deeper the node and the
+     * later the move, and smaller the better its history score.
+     * @param depth - remaining depth of the node, in plies
+     * @param moveNum - number of the move in the order of MovePicker, counting from 1
+     * @param move - the move
+     * @param color - color of the player making the move: WHITE or BLACK
+     * @return the reduction, in plies; at least 0, and leaving at least 1 ply to search
+     */
+    int _lateMoveReduction(int depth, int moveNum, Move move, int color) const;
+
+    /**
+     * @brief searches the captures and promotions of the current position until it's quiet, so
+     * that a position isn't evaluated in the middle of an exchange. the player to move may stand
+     * pat on the static evaluation, and captures that lose material by static exchange
+     * evaluation are skipped.
+     * @param ply - distance from the root, in plies
+     * @param alpha - score the player to move is already assured of
+     * @param beta - score the opponent is already assured of
+     * @return score of the position, from the point of view of the player to move, bounded by
+     * alpha and beta; meaningless if the search was stopped
+     */
+    int _quiescence(int ply, int alpha, int beta);
+
+    /**
+     * @brief searches the current position with a fail-hard negamax alpha-beta search, and
+     * records its principal variation. moves are tried in the order of MovePicker, with the
+     * previous iteration's principal variation, or else the transposition table's move, first;
+     * the moves after the first are searched with a null window, and again with the full one if
+     * they turn out to beat alpha. the enabled techniques of SearchLimits::pruning cut or reduce
+     * the nodes that are unlikely to matter.
+     * @param depth - remaining depth, in plies
+     * @param ply - distance from the root, in plies
+     * @param alpha - score the player to move is already assured of
+     * @param beta - score the opponent is already assured of
+     * @param isNullMoveAllowed - false right after a null move, so that two aren't made in a row
+     * @return score of the position, from the point of view of the player to move, bounded by
+     * alpha and beta; meaningless if the search was stopped
+     */
+    int _negamax(int depth, int ply, int alpha, int beta, bool isNullMoveAllowed = true);
+
+public:
+    /**
+     * @brief a constructor for Search
+     * @param root - the position to be searched, which is copied
+     * @param limits - the budget of the search
+     * @param table - the transposition table, which may be shared with other searches
+     * @param shared - the state shared by the threads of the search
+     * @param threadIndex - index of the thread running Search; 0 for the main thread
+     */
+    Search(const Board& root, const SearchLimits& limits, TranspositionTable& table,
+           SharedSearchState& shared, int threadIndex);
+
+    /**
+     * @brief runs the iterative deepening until it's stopped. the main thread prints the score,
+     * node count of all threads, speed, table hit rates, effective branching factor, first-move
+     * cutoff rate and principal variation of every completed iteration.
+     * @param out - stream to which every iteration is reported, one line per iteration
+     * @return the result of the last completed iteration
+     */
+    SearchResult run(std::ostream& out);
+};
+
+// ------------------- function declarations -------------------
+
+/**
+ * @brief searches a position for the best move within the given limits.
+ * @param position - the position
+ * @param limits - the budget of the search
+ * @param table - the transposition table, kept between searches
+ * @param out - stream to which every iteration is reported, one line per iteration
+ * @param threadNum - number of threads searching in parallel. assumes: threadNum is at least 1.
+ * @return the best move and the line, score and statistics of the search; the node count covers
+ * all threads
+ */
+SearchResult bestMove(const Board& position, const SearchLimits& limits, TranspositionTable& table,
+                      std::ostream& out, int threadNum = 1);
+
+#endif //CHESS_CPP_SEARCH_H
\ No newline at end of file
@@ -0,0 +1,115 @@
+// Square.h
+
+#ifndef CHESS_CPP_SQUARE_H
+#define CHESS_CPP_SQUARE_H
+
+// ------------------------- includes --------------------------
+
+#include <cstdint>
+#include <string>
+
+using std::string;
+
+// --------------------- const definitions ---------------------
+
+// max rank in board
+constexpr char MAX_RANK = '8';
+// min rank in board
+constexpr char MIN_RANK = '1';
+// max file in board
+constexpr char MAX_FILE = 'H';
+// min file in board
+constexpr char MIN_FILE = 'A';
+// number of ranks / files in board
+constexpr int BOARD_SIZE = 8;
+// number of squares in board
+constexpr int BOARD_SQUARES = BOARD_SIZE * BOARD_SIZE;
+// file's index in a square's name, e.g. A1
+constexpr int FILE_INDEX = 0;
+// rank's index in a square's name, e.g. A1
+constexpr int RANK_INDEX = 1;
+// length of a square's name, e.g. A1
+constexpr int SQUARE_NAME_LENGTH = 2;
+
+/**
+ * a square on the board, numbered file + 8 * rank, from A1 = 0 to H8 = 63.
+ */
+enum Square : int8_t
+{
+    A1, B1, C1, D1, E1, F1, G1, H1,
+    A2, B2, C2, D2, E2, F2, G2, H2,
+    A3, B3, C3, D3, E3, F3, G3, H3,
+    A4, B4, C4, D4, E4, F4, G4, H4,
+    A5, B5, C5, D5, E5, F5, G5, H5,
+    A6, B6, C6, D6, E6, F6, G6, H6,
+    A7, B7, C7, D7, E7, F7, G7, H7,
+    A8, B8, C8, D8, E8, F8, G8, H8,
+    NO_SQUARE
+};
+
+/**
+ * a set of squares on the board, one bit per square: bit i is set if Square(i) is in the set.
+ */
+typedef uint64_t Bitboard;
+
+// ------------------- function declarations -------------------
+
+/**
+ * @brief returns the file of a square, counting from 0 (the "A" file)
+ * @param square - a square on the board
+ * @return file of square, between 0 and 7
+ */
+constexpr int fileOf(Square square) {return square % BOARD_SIZE; }
+
+/**
+ * @brief returns the rank of a square, counting from 0 (the first rank)
+ * @param square - a square on the board
+ * @return rank of square, between 0 and 7
+ */
+constexpr int rankOf(Square square) {return square / BOARD_SIZE; }
+
+/**
+ * @brief checks whether the given file and rank are on the board
+ * @param file - file index, counting from 0
+ * @param rank - rank index, counting from 0
+ * @return true if (file, rank) is a square on the board; false otherwise
+ */
+constexpr bool isOnBoard(int file, int rank)
+{
+    return (file >= 0) && (file < BOARD_SIZE) && (rank >= 0) && (rank < BOARD_SIZE);
+}
+
+/**
+ * @brief returns the square at the given file and rank. assumes: isOnBoard(file, rank).
+ * @param file - file index, counting from 0
+ * @param rank - rank index, counting from 0
+ * @return the square at (file, rank)
+ */
+constexpr Square makeSquare(int file, int rank) {return Square(file + BOARD_SIZE * rank); }
+
+/**
+ * @brief parses the name of a square
+ * @param name - a string in the format <char><int>, e.g. A1
+ * @return the named square; NO_SQUARE if name isn't a square on the board
+ */
+inline Square parseSquare(const string& name)
+{
+    if (name.size() != SQUARE_NAME_LENGTH)
+    {
+        return NO_SQUARE;
+    }
+    int file = name[FILE_INDEX] - MIN_FILE, rank = name[RANK_INDEX] - MIN_RANK;
+    return (isOnBoard(file, rank) ? makeSquare(file, rank): NO_SQUARE);
+}
+
+/**
+ * @brief returns the name of a square
+ * @param square - a square on the board
+ * @return name of the square, e.g. A1
+ */
+inline string squareName(Square square)
+{
+    return string(1, char(MIN_FILE + fileOf(square))) + string(1, char(MIN_RANK + rankOf(square)));
+}
+
+#endif //CHESS_CPP_SQUARE_H
\ No newline at end of file
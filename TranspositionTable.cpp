@@ -0,0 +1,212 @@
+// TranspositionTable.cpp
+// This file contains the implementation of the class TranspositionTable
+
+// ------------------------- includes --------------------------
+
+#include "TranspositionTable.h"
+
+// --------------------- const definitions ---------------------
+
+// bytes in a megabyte
+constexpr size_t BYTES_IN_MB = 1024 * 1024;
+// offsets of the fields of an entry's packed data, in bits
+constexpr int MOVE_SHIFT = 0, SCORE_SHIFT = 16, DEPTH_SHIFT = 32, BOUND_SHIFT = 40, AGE_SHIFT = 48;
+// masks of the fields of an entry's packed data, once shifted down
+constexpr uint64_t MOVE_MASK = 0xFFFF, SCORE_MASK = 0xFFFF, DEPTH_MASK = 0xFF, BOUND_MASK = 0xFF,
+        AGE_MASK = 0xFF;
+// how many plies of depth an entry is worth per search it is older than the current one, when
+// choosing the entry to replace
+constexpr int AGE_WEIGHT = 8;
+// how many plies shallower than a stored entry of the same position a new result may be, and still
+// replace it
+constexpr int REPLACE_DEPTH_MARGIN = 2;
+// number of buckets sampled to estimate the fill rate
+constexpr uint64_t FILL_SAMPLE_BUCKETS = 250;
+// permille of a whole
+constexpr int PERMILLE = 1000;
+
+// ----------------------  implementation ----------------------
+
+/**
+ * @brief returns the age field of an entry's packed data
+ * @param data - packed data of an entry
+ * @return age of the search that wrote the entry
+ */
+static uint8_t _ageOf(uint64_t data)
+{
+    return uint8_t((data >> AGE_SHIFT) & AGE_MASK);
+}
+
+/**
+ * @brief returns the bound field of an entry's packed data
+ * @param data - packed data of an entry
+ * @return bound of the entry; NO_BOUND if it's empty
+ */
+static Bound _boundOf(uint64_t data)
+{
+    return Bound((data >> BOUND_SHIFT) & BOUND_MASK);
+}
+
+/**
+ * @brief returns the move field of an entry's packed data
+ * @param data - packed data of an entry
+ * @return packed data of the entry's best move; 0 if none
+ */
+static uint16_t _moveOf(uint64_t data)
+{
+    return uint16_t((data >> MOVE_SHIFT) & MOVE_MASK);
+}
+
+/**
+ * @brief returns the depth field of an entry's packed data
+ * @param data - packed data of an entry
+ * @return depth of the entry's search, in plies
+ */
+static int _depthOf(uint64_t data)
+{
+    return int((data >> DEPTH_SHIFT) & DEPTH_MASK);
+}
+
+// ------------------- class implementation --------------------
+
+/**
+ * @brief a constructor for TranspositionTable. the table is empty.
+ * @param megabytes - size of the table: the largest power of two of buckets fitting in it.
+ * assumes: megabytes is at least 1.
+ */
+TranspositionTable::TranspositionTable(size_t megabytes)
+{
+    resize(megabytes);
+}
+
+/**
+ * @brief reallocates the table with a new size, and empties it. must not be called while a search
+ * uses the table.
+ * @param megabytes - size of the table. assumes: megabytes is at least 1.
+ */
+void TranspositionTable::resize(size_t megabytes)
+{
+    uint64_t bucketNum = 1;
+    while (bucketNum * 2 * sizeof(Bucket) <= megabytes * BYTES_IN_MB)
+    {
+        bucketNum *= 2;
+    }
+    _buckets.reset(new Bucket[bucketNum]);
+    _bucketMask = bucketNum - 1;
+    clear();
+}
+
+/**
+ * @brief empties the table. must not be called while a search uses the table.
+ */
+void TranspositionTable::clear()
+{
+    for (uint64_t i = 0; i <= _bucketMask; i++)
+    {
+        for (Slot& slot: _buckets[i].slots)
+        {
+            slot.check.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    _age = 0;
+}
+
+/**
+ * @brief starts a new search: entries written by earlier searches become older, and so preferred
+ * for replacement. must not be called while a search uses the table.
+ */
+void TranspositionTable::newSearch()
+{
+    _age = uint8_t((_age + 1) & AGE_MASK);
+}
+
+/**
+ * @brief looks up the search result of a position
+ * @param key - Zobrist key of the position
+ * @param entry - non-const ref, to which the function assigns the stored result if found
+ * @return true if the table holds a result for key; false otherwise
+ */
+bool TranspositionTable::probe(Key key, TableEntry& entry) const
+{
+    for (const Slot& slot: _getBucket(key).slots)
+    {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if (((check ^ data) != key) || (_boundOf(data) == NO_BOUND))
+        {
+            continue;
+        }
+        entry.move = Move::fromData(_moveOf(data));
+        entry.score = int16_t((data >> SCORE_SHIFT) & SCORE_MASK);
+        entry.depth = _depthOf(data);
+        entry.bound = _boundOf(data);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief stores the search result of a position. an entry of the same position is kept instead if
+ * the current search wrote it more than REPLACE_DEPTH_MARGIN plies deeper, unless the result is
+ * exact; a result without a move keeps the move of the entry it replaces.
+ * @param key - Zobrist key of the position
+ * @param entry - the result. assumes: its score fits in 16 bits and its depth in 8 bits.
+ */
+void TranspositionTable::store(Key key, const TableEntry& entry)
+{
+    Slot* replaced = nullptr;
+    int replacedWorth = 0;
+    uint16_t move = entry.move.getData();
+    for (Slot& slot: _getBucket(key).slots)
+    {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if ((check ^ data) == key)
+        {
+            if (move == 0)
+            {
+                move = _moveOf(data);
+            }
+            if ((entry.bound != EXACT_BOUND) && (_ageOf(data) == _age) &&
+                (entry.depth + REPLACE_DEPTH_MARGIN < _depthOf(data)))
+            {
+                // a deeper result of the current search is kept; its age is already current
+                return;
+            }
+            replaced = &slot;
+            break;
+        }
+        int age = (_age - _ageOf(data)) & AGE_MASK;
+        int worth = (_boundOf(data) == NO_BOUND ? -1: _depthOf(data) - AGE_WEIGHT * age);
+        if ((replaced == nullptr) || (worth < replacedWorth))
+        {
+            replaced = &slot;
+            replacedWorth = worth;
+        }
+    }
+    uint64_t data = (uint64_t(move) << MOVE_SHIFT) |
+                    (uint64_t(uint16_t(entry.score)) << SCORE_SHIFT) |
+                    (uint64_t(entry.depth) << DEPTH_SHIFT) |
+                    (uint64_t(entry.bound) << BOUND_SHIFT) | (uint64_t(_age) << AGE_SHIFT);
+    replaced->check.store(key ^ data, std::memory_order_relaxed);
+    replaced->data.store(data, std::memory_order_relaxed);
+}
+
+/**
+ * @brief estimates the fill rate of the table from a sample of its buckets
+ * @return permille of the sampled entries written by the current search
+ */
+int TranspositionTable::fillRate() const
+{
+    uint64_t sampled = std::min(FILL_SAMPLE_BUCKETS, _bucketMask + 1), filled = 0;
+    for (uint64_t i = 0; i < sampled; i++)
+    {
+        for (const Slot& slot: _buckets[i].slots)
+        {
+            uint64_t data = slot.data.load(std::memory_order_relaxed);
+            filled += (_boundOf(data) != NO_BOUND) && (_ageOf(data) == _age);
+        }
+    }
+    return int(filled * PERMILLE / (sampled * BUCKET_ENTRIES));
+}
\ No newline at end of file
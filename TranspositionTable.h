@@ -0,0 +1,144 @@
+// TranspositionTable.h
+
+#ifndef CHESS_CPP_TRANSPOSITIONTABLE_H
+#define CHESS_CPP_TRANSPOSITIONTABLE_H
+
+// ------------------------- includes --------------------------
+
+#include <atomic>
+#include <memory>
+#include "Move.h"
+#include "Zobrist.h"
+
+// --------------------- const definitions ---------------------
+
+// default size of a transposition table, in megabytes
+constexpr size_t DEFAULT_TABLE_MEGABYTES = 16;
+// size of a cache line, in bytes. a bucket fills exactly one.
+constexpr size_t CACHE_LINE_SIZE = 64;
+// number of entries in a bucket
+constexpr int BUCKET_ENTRIES = 4;
+
+/**
+ * the relation of a stored score to the position's true score
+ */
+enum Bound : uint8_t
+{
+    NO_BOUND, /** the entry is empty */
+    UPPER_BOUND, /** the search failed low: the true score is at most the stored one */
+    LOWER_BOUND, /** the search failed high: the true score is at least the stored one */
+    EXACT_BOUND /** the stored score is the true score */
+};
+
+// --------------------- struct declaration --------------------
+
+/**
+ * the result of a search of a position, as stored in a transposition table
+ */
+struct TableEntry
+{
+    Move move; /** best move found; a null move if none */
+    int score = 0; /** score of the position */
+    int depth = 0; /** depth of the search, in plies */
+    Bound bound = NO_BOUND; /** relation of score to the true score */
+};
+
+// --------------------- class declaration ---------------------
+
+/**
+ * This class represents a transposition table: a fixed-size hash table of search results, keyed
+ * by the positions' Zobrist keys and shared by all search threads without locks. the table is a
+ * power-of-two array of cache-line buckets, each holding BUCKET_ENTRIES entries. an entry is two
+ * 64-bit words, its packed data and its key XORed with that data; a reader accepts an entry only
+ * if XORing the words gives back its key, so an entry torn by concurrent writers is discarded as a
+ * miss. a new entry replaces the entry of its bucket with the same key, or else the one that is
+ * shallowest and oldest, i.e. written by the earliest search.
+ */
+class TranspositionTable
+{
+private:
+    /**
+     * an entry as stored: its packed data, and its key XORed with that data
+     */
+    struct Slot
+    {
+        std::atomic<uint64_t> check; /** key ^ data */
+        std::atomic<uint64_t> data; /** move, score, depth, bound and age, packed */
+    };
+
+    /**
+     * a group of entries sharing a cache line, among which a key may be stored
+     */
+    struct alignas(CACHE_LINE_SIZE) Bucket
+    {
+        Slot slots[BUCKET_ENTRIES]; /** the entries */
+    };
+
+    static_assert(sizeof(Bucket) == CACHE_LINE_SIZE, "a bucket must fill one cache line");
+
+    std::unique_ptr<Bucket[]> _buckets; /** the buckets */
+    uint64_t _bucketMask = 0; /** number of buckets minus 1; maps a key to its bucket */
+    uint8_t _age = 0; /** age of the current search, stored in the entries it writes */
+
+    /**
+     * @brief returns the bucket in which the given key is stored
+     * @param key - Zobrist key of a position
+     * @return the key's bucket
+     */
+    Bucket& _getBucket(Key key) const {return _buckets[key & _bucketMask]; }
+
+public:
+    /**
+     * @brief a constructor for TranspositionTable. the table is empty.
+     * @param megabytes - size of the table: the largest power of two of buckets fitting in it.
+     * assumes: megabytes is at least 1.
+     */
+    explicit TranspositionTable(size_t megabytes = DEFAULT_TABLE_MEGABYTES);
+
+    /**
+     * @brief reallocates the table with a new size, and empties it. must not be called while a
+     * search uses the table.
+     * @param megabytes - size of the table. assumes: megabytes is at least 1.
+     */
+    void resize(size_t megabytes);
+
+    /**
+     * @brief empties the table. must not be called while a search uses the table.
+     */
+    void clear();
+
+    /**
+     * @brief starts a new search: entries written by earlier searches become older, and so
+     * preferred for replacement. must not be called while a search uses the table.
+     */
+    void newSearch();
+
+    /**
+     * @brief looks up the search result of a position
+     * @param key - Zobrist key of the position
+     * @param entry - non-const ref, to which the function assigns the stored result if found
+     * @return true if the table holds a result for key; false otherwise
+     */
+    bool probe(Key key, TableEntry& entry) const;
+
+    /**
+     * @brief stores the search result of a position
+     * @param key - Zobrist key of the position
+     * @param entry - the result. assumes: its score fits in 16 bits and its depth in 8 bits.
+     */
+    void store(Key key, const TableEntry& entry);
+
+    /**
+     * @brief estimates the fill rate of the table from a sample of its buckets
+     * @return permille of the sampled entries written by the current search
+     */
+    int fillRate() const;
+
+    /**
+     * @brief returns the size of the table
+     * @return size of the buckets, in bytes
+     */
+    size_t size() const {return (_bucketMask + 1) * sizeof(Bucket); }
+};
+
+#endif //CHESS_CPP_TRANSPOSITIONTABLE_H
\ No newline at end of file
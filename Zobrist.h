@@ -0,0 +1,122 @@
+// Zobrist.h
+
+#ifndef CHESS_CPP_ZOBRIST_H
+#define CHESS_CPP_ZOBRIST_H
+
+// ------------------------- includes --------------------------
+
+#include <cstdint>
+#include "Piece.h"
+
+// --------------------- const definitions ---------------------
+
+/**
+ * a 64-bit hash key identifying a position: the XOR of a random key per piece on its square, the
+ * side to move, the castling rights and the en passant file.
+ */
+typedef uint64_t Key;
+
+// number of castling rights combinations
+constexpr int CASTLING_COMBINATIONS = 16;
+// seed of the key generator
+constexpr uint64_t ZOBRIST_SEED = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * the random keys of all position features
+ */
+struct ZobristKeys
+{
+    /** indexed by colorIndex(), PieceType and Square */
+    Key pieces[COLOR_NUM][PIECE_TYPE_NUM][BOARD_SQUARES];
+    Key castling[CASTLING_COMBINATIONS]; /** indexed by castling rights */
+    Key enPassant[BOARD_SIZE]; /** indexed by the en passant square's file */
+    Key blackToMove; /** XORed in when black is to move */
+};
+
+/**
+ * @brief returns the next number of a splitmix64 pseudo-random sequence
+ * @param state - non-const ref to the state of the sequence, which is advanced
+ * @return the next pseudo-random number
+ */
+constexpr uint64_t _nextRandom(uint64_t& state)
+{
+    state += 0x9E3779B97F4A7C15ULL;
+    uint64_t random = state;
+    random = (random ^ (random >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    random = (random ^ (random >> 27)) * 0x94D049BB133111EBULL;
+    return random ^ (random >> 31);
+}
+
+/**
+ * @brief generates the random keys of all position features at compile time
+ * @return the keys
+ */
+constexpr ZobristKeys _createZobristKeys()
+{
+    ZobristKeys keys = {};
+    uint64_t state = ZOBRIST_SEED;
+    for (auto& colorKeys: keys.pieces)
+    {
+        for (auto& typeKeys: colorKeys)
+        {
+            for (Key& key: typeKeys)
+            {
+                key = _nextRandom(state);
+            }
+        }
+    }
+    keys.castling[0] = 0; // no castling rights leave the key unchanged
+    for (int rights = 1; rights < CASTLING_COMBINATIONS; rights++)
+    {
+        keys.castling[rights] = _nextRandom(state);
+    }
+    for (Key& key: keys.enPassant)
+    {
+        key = _nextRandom(state);
+    }
+    keys.blackToMove = _nextRandom(state);
+    return keys;
+}
+
+// the random keys of all position features
+inline constexpr ZobristKeys ZOBRIST = _createZobristKeys();
+
+// ------------------- function declarations -------------------
+
+/**
+ * @brief returns the key of a piece on a square
+ * @param color - color of the piece: WHITE or BLACK
+ * @param type - type of the piece
+ * @param square - the piece's square
+ * @return the key of the piece on square
+ */
+constexpr Key pieceKey(int color, PieceType type, Square square)
+{
+    return ZOBRIST.pieces[colorIndex(color)][type][square];
+}
+
+/**
+ * @brief returns the key of the castling rights
+ * @param rights - castling rights, e.g. WHITE_KINGSIDE | BLACK_QUEENSIDE
+ * @return the key of the castling rights
+ */
+constexpr Key castlingKey(int rights) {return ZOBRIST.castling[rights]; }
+
+/**
+ * @brief returns the key of the en passant square
+ * @param square - the en passant square; NO_SQUARE if there is none
+ * @return the key of the en passant square's file; 0 if square is NO_SQUARE
+ */
+constexpr Key enPassantKey(Square square)
+{
+    return (square == NO_SQUARE ? 0: ZOBRIST.enPassant[fileOf(square)]);
+}
+
+/**
+ * @brief returns the key of the side to move
+ * @param color - color of the player to move: WHITE or BLACK
+ * @return the key of the side to move
+ */
+constexpr Key sideKey(int color) {return (color == BLACK ? ZOBRIST.blackToMove: 0); }
+
+#endif //CHESS_CPP_ZOBRIST_H
\ No newline at end of file
@@ -0,0 +1,445 @@
+// benchMain.cpp
+// This file contains the main function of the bench program, which measures the throughput of the
+// board's hot queries and of the network's evaluation, the time-to-depth speedup of the parallel
+// search, or the effect of the search's selective pruning, or checks the network's incremental
+// accumulator and SIMD kernels against its plain computation.
+
+// ------------------------- includes --------------------------
+
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <vector>
+#include "Search.h"
+
+using std::vector;
+
+// --------------------- const definitions ---------------------
+
+// positions the benchmarks run on
+constexpr const char* BENCH_FENS[] = {
+        START_FEN,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"
+};
+// depth of the move tree whose positions the benchmarks visit
+constexpr int BENCH_DEPTH = 3;
+// number of times each query is repeated in a visited position
+constexpr int BENCH_REPEATS = 16;
+// nanoseconds in a second
+constexpr double NANOSECONDS = 1e9;
+// bytes in a kilobyte
+constexpr size_t BYTES_IN_KB = 1024;
+// flag selecting the slider attack backend
+constexpr auto BACKEND_FLAG = "--backend";
+// flag loading a network file, which then evaluates in the searches and is benchmarked
+constexpr auto NNUE_FLAG = "--nnue";
+// flag running the parallel search benchmark
+constexpr auto SMP_FLAG = "--smp";
+// flag running the selective pruning benchmark
+constexpr auto PRUNING_FLAG = "--pruning";
+// flag running the network self-check
+constexpr auto NNUE_CHECK_FLAG = "--nnue-check";
+// error message of a network file that can't be loaded, followed by its path
+constexpr auto INVALID_NNUE_MESSAGE = "invalid network file: ";
+// usage message
+constexpr auto USAGE_MESSAGE =
+        "Usage: bench [--backend magic|pext] [--nnue <file>] [--smp [depth] | --pruning [depth] | "
+        "--nnue-check [depth]]";
+// thread counts the parallel search benchmark compares
+constexpr int SMP_THREAD_NUMS[] = {1, 2, 4, 8, 16};
+// default depth of the parallel search benchmark
+constexpr int DEFAULT_SMP_DEPTH = 7;
+// size of the transposition table of the parallel search benchmark, in megabytes
+constexpr size_t SMP_TABLE_MEGABYTES = 64;
+// milliseconds in a second
+constexpr uint64_t MILLISECONDS = 1000;
+// default depth of the selective pruning benchmark
+constexpr int DEFAULT_PRUNING_DEPTH = 7;
+// default depth of the move tree the network self-check walks
+constexpr int DEFAULT_NNUE_CHECK_DEPTH = 3;
+// seed of the network the self-check builds when no network file is given
+constexpr uint64_t NNUE_CHECK_SEED = 0x5EED;
+// kernels the network self-check compares, the first being the reference
+constexpr NnueKernel NNUE_CHECK_KERNELS[] = {SCALAR_KERNEL, SSE41_KERNEL, AVX2_KERNEL};
+
+/**
+ * a tactical test position and the move that solves it
+ */
+struct TacticalTest
+{
+    const char* fen; /** the position */
+    const char* bestMove; /** name of the solving move, e.g. G3G6 */
+};
+
+// tactical test positions, from the Win at Chess suite
+constexpr TacticalTest TACTICAL_TESTS[] = {
+        {"2rr3k/pp3pp1/1nnqbN1p/3pN3/2pP4/2P3Q1/PPB4P/R4RK1 w - - 0 1", "G3G6"},
+        {"8/7p/5k2/5p2/p1p2P2/Pr1pPK2/1P1R3P/8 b - - 0 1", "B3B2"},
+        {"5rk1/1ppb3p/p1pb4/6q1/3P1p1r/2P1R2P/PP1BQ1P1/5RKN w - - 0 1", "E3G3"},
+        {"r1bq2rk/pp3pbp/2p1p1pQ/7P/3P4/2PB1N2/PP3PPR/2KR4 w - - 0 1", "H6H7"},
+        {"5k2/6pp/p1qN4/1p1p4/3P4/2PKP2Q/PP3r2/3R4 b - - 0 1", "C6C4"},
+        {"7k/p7/1R5K/6r1/6p1/6P1/8/8 w - - 0 1", "B6B7"},
+        {"rnbqkb1r/pppp1ppp/8/4P3/6n1/7P/PPPNPPP1/R1BQKBNR b KQkq - 0 1", "G4E3"},
+        {"r4q1k/p2bR1rp/2p2Q1N/5p2/5p2/2P5/PP3PPP/R5K1 w - - 0 1", "E7F7"},
+        {"3q1rk1/p4pp1/2pb3p/3p4/6Pr/1PNQ4/P1PB1PP1/4RRK1 b - - 0 1", "D6H2"},
+        {"2br2k1/2q3rn/p2NppQ1/2p1P3/Pp5R/4P3/1P3PPP/3R2K1 w - - 0 1", "H4H7"}
+};
+
+/**
+ * a combination of selective pruning techniques that the pruning benchmark compares
+ */
+struct PruningConfig
+{
+    const char* name; /** name of the combination */
+    int pruning; /** the Pruning flags enabled */
+};
+
+// combinations of selective pruning techniques that the pruning benchmark compares
+constexpr PruningConfig PRUNING_CONFIGS[] = {
+        {"all", ALL_PRUNING},
+        {"no null move", ALL_PRUNING & ~NULL_MOVE_PRUNING},
+        {"no reductions", ALL_PRUNING & ~LATE_MOVE_REDUCTIONS},
+        {"no futility", ALL_PRUNING & ~FUTILITY_PRUNING},
+        {"none", NO_PRUNING}
+};
+
+// ----------------------  implementation ----------------------
+
+/**
+ * @brief runs a query in every position of the move tree to the given depth
+ * @param board - the root position, left unchanged
+ * @param depth - depth of the tree, in plies
+ * @param query - function that runs the query on a position and returns the number of calls made
+ * @param result - non-const ref, to which the query adds its results so that they aren't optimized
+ * away
+ * @return number of calls made
+ */
+template <class Query>
+static uint64_t _walk(Board& board, int depth, Query& query, uint64_t& result)
+{
+    uint64_t calls = query(board, result);
+    if (depth == 0)
+    {
+        return calls;
+    }
+    MoveList moves;
+    generateLegalMoves(board, moves);
+    for (Move move: moves)
+    {
+        board.makeMove(move);
+        calls += _walk(board, depth - 1, query, result);
+        board.unmakeMove();
+    }
+    return calls;
+}
+
+/**
+ * @brief runs a query in every position of the bench trees, and prints its throughput
+ * @param name - name of the benchmark
+ * @param query - function that runs the query on a position and returns the number of calls made
+ */
+template <class Query>
+static void _bench(const char* name, Query query)
+{
+    uint64_t calls = 0, result = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const char* fen: BENCH_FENS)
+    {
+        Board board;
+        board.setPosition(fen);
+        calls += _walk(board, BENCH_DEPTH, query, result);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << calls << " calls, " << elapsed.count() * NANOSECONDS / calls
+              << " ns/call (result " << result << ")" << std::endl;
+}
+
+/**
+ * @brief searches every bench position to the given depth with every thread count, starting from an
+ * empty transposition table, and prints the time-to-depth speedup over a single thread.
+ * @param depth - depth of every search, in plies
+ */
+static void _benchSmp(int depth)
+{
+    TranspositionTable table(SMP_TABLE_MEGABYTES);
+    SearchLimits limits;
+    limits.depth = depth;
+    std::ostream silent(nullptr);
+    uint64_t singleMilliseconds = 0;
+    for (int threadNum: SMP_THREAD_NUMS)
+    {
+        uint64_t nodes = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const char* fen: BENCH_FENS)
+        {
+            Board board;
+            board.setPosition(fen);
+            table.clear();
+            nodes += bestMove(board, limits, table, silent, threadNum).nodes;
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        uint64_t milliseconds = std::max<uint64_t>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 1);
+        singleMilliseconds = (threadNum == 1 ? milliseconds: singleMilliseconds);
+        std::cout << "threads " << threadNum << ": depth " << depth << " in " << milliseconds
+                  << " ms, nodes " << nodes << ", nodes/sec " << nodes * MILLISECONDS / milliseconds
+                  << ", speedup " << double(singleMilliseconds) / milliseconds << std::endl;
+    }
+}
+
+/**
+ * @brief searches every bench position and every tactical test position to the given depth with
+ * every combination of selective pruning, starting from an empty transposition table, and prints
+ * the time-to-depth and the number of solved tactical tests.
+ * @param depth - depth of every search, in plies
+ */
+static void _benchPruning(int depth)
+{
+    TranspositionTable table(SMP_TABLE_MEGABYTES);
+    std::ostream silent(nullptr);
+    for (const PruningConfig& config: PRUNING_CONFIGS)
+    {
+        SearchLimits limits;
+        limits.depth = depth;
+        limits.pruning = config.pruning;
+        uint64_t nodes = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const char* fen: BENCH_FENS)
+        {
+            Board board;
+            board.setPosition(fen);
+            table.clear();
+            nodes += bestMove(board, limits, table, silent).nodes;
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        int solved = 0;
+        for (const TacticalTest& test: TACTICAL_TESTS)
+        {
+            Board board;
+            board.setPosition(test.fen);
+            table.clear();
+            solved += (moveName(bestMove(board, limits, table, silent).bestMove) == test.bestMove);
+        }
+        std::cout << "pruning " << config.name << ": depth " << depth << " in "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()
+                  << " ms, nodes " << nodes << ", solved " << solved << "/"
+                  << std::size(TACTICAL_TESTS) << std::endl;
+    }
+}
+
+/**
+ * @brief walks the move tree to the given depth, pushing and popping the network's accumulator
+ * with every move, and checks after every push and pop that the incremental accumulator equals
+ * the one computed from scratch.
+ * @param board - the root position, left unchanged
+ * @param nnue - non-const ref to the evaluator, whose latest accumulator is the root's
+ * @param depth - depth of the tree, in plies
+ * @param evaluations - non-const ref, to which the evaluation of every visited position is added
+ * @return true if every accumulator matched; false otherwise
+ */
+static bool _walkNnue(Board& board, NnueEvaluator& nnue, int depth, vector<int>& evaluations)
+{
+    evaluations.push_back(nnue.evaluate(board));
+    if (depth == 0)
+    {
+        return true;
+    }
+    MoveList moves;
+    generateLegalMoves(board, moves);
+    for (Move move: moves)
+    {
+        nnue.push(board, move);
+        board.makeMove(move);
+        bool matches = nnue.matchesRefresh(board);
+        if (!matches)
+        {
+            std::cout << "nnue check: accumulator mismatch after pushing " << moveName(move)
+                      << std::endl;
+        }
+        matches = matches && _walkNnue(board, nnue, depth - 1, evaluations);
+        board.unmakeMove();
+        nnue.pop();
+        if (!matches)
+        {
+            return false;
+        }
+        if (!nnue.matchesRefresh(board))
+        {
+            std::cout << "nnue check: accumulator mismatch after popping " << moveName(move)
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief checks the network with every kernel the CPU supports: walks the bench trees to the given
+ * depth, checking the incremental accumulator against the one computed from scratch, and checks
+ * that every kernel evaluates every position the same as the scalar kernel. checks the loaded
+ * network, or else one built from a fixed seed.
+ * @param depth - depth of the trees, in plies
+ * @return true if all checks passed; false otherwise
+ */
+static bool _checkNnue(int depth)
+{
+    std::unique_ptr<Network> seeded;
+    const Network* network = getNetwork();
+    if (network == nullptr)
+    {
+        seeded = std::make_unique<Network>();
+        seeded->randomize(NNUE_CHECK_SEED);
+        network = seeded.get();
+    }
+    vector<int> reference;
+    for (NnueKernel kernel: NNUE_CHECK_KERNELS)
+    {
+        if (!setNnueKernel(kernel))
+        {
+            continue;
+        }
+        NnueEvaluator nnue(*network);
+        vector<int> evaluations;
+        for (const char* fen: BENCH_FENS)
+        {
+            Board board;
+            board.setPosition(fen);
+            nnue.reset(board);
+            if (!_walkNnue(board, nnue, depth, evaluations))
+            {
+                std::cout << "nnue check " << nnueKernelName() << ": FAILED" << std::endl;
+                return false;
+            }
+        }
+        reference = (reference.empty() ? evaluations: reference);
+        if (evaluations != reference)
+        {
+            std::cout << "nnue check " << nnueKernelName()
+                      << ": FAILED, evaluations differ from the scalar kernel" << std::endl;
+            return false;
+        }
+        std::cout << "nnue check " << nnueKernelName() << ": " << evaluations.size()
+                  << " positions ok" << std::endl;
+    }
+    return true;
+}
+
+/**
+ * The main function of the bench program. prints the throughput of every benchmark, with the
+ * slider attack backend selected at startup or by the command line, or runs the parallel search
+ * or the selective pruning benchmark, or the network self-check. the network benchmarks run, and
+ * the searches evaluate with the network, only if a network file is given.
+ */
+int main(int argc, char* argv[])
+{
+    int arg = 1;
+    if ((argc > arg + 1) && (std::strcmp(argv[arg], BACKEND_FLAG) == 0))
+    {
+        if (!setSliderBackend(argv[arg + 1]))
+        {
+            std::cerr << USAGE_MESSAGE << std::endl;
+            return EXIT_FAILURE;
+        }
+        arg += 2;
+    }
+    if ((argc > arg + 1) && (std::strcmp(argv[arg], NNUE_FLAG) == 0))
+    {
+        if (!loadNetwork(argv[arg + 1]))
+        {
+            std::cerr << INVALID_NNUE_MESSAGE << argv[arg + 1] << std::endl;
+            return EXIT_FAILURE;
+        }
+        arg += 2;
+    }
+    if ((argc > arg) && (std::strcmp(argv[arg], SMP_FLAG) == 0))
+    {
+        int depth = (argc > arg + 1 ? std::atoi(argv[arg + 1]): DEFAULT_SMP_DEPTH);
+        _benchSmp(std::max(depth, 1));
+        return EXIT_SUCCESS;
+    }
+    if ((argc > arg) && (std::strcmp(argv[arg], PRUNING_FLAG) == 0))
+    {
+        int depth = (argc > arg + 1 ? std::atoi(argv[arg + 1]): DEFAULT_PRUNING_DEPTH);
+        _benchPruning(std::max(depth, 1));
+        return EXIT_SUCCESS;
+    }
+    if ((argc > arg) && (std::strcmp(argv[arg], NNUE_CHECK_FLAG) == 0))
+    {
+        int depth = (argc > arg + 1 ? std::atoi(argv[arg + 1]): DEFAULT_NNUE_CHECK_DEPTH);
+        return (_checkNnue(std::max(depth, 1)) ? EXIT_SUCCESS: EXIT_FAILURE);
+    }
+    if (argc > arg)
+    {
+        std::cerr << USAGE_MESSAGE << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "slider attack backend: " << sliderBackendName() << std::endl;
+    std::cout << "slider attack tables: " << sliderTablesSize() / BYTES_IN_KB << " KB" << std::endl;
+    _bench("sliderAttacks", [](Board& board, uint64_t& result) {
+        Bitboard occupied = board.getOccupancy();
+        for (int square = 0; square < BOARD_SQUARES; square++)
+        {
+            result += rookAttacks(Square(square), occupied);
+            result += bishopAttacks(Square(square), occupied);
+        }
+        return uint64_t(2 * BOARD_SQUARES);
+    });
+    _bench("isInCheck", [](Board& board, uint64_t& result) {
+        for (int i = 0; i < BENCH_REPEATS; i++)
+        {
+            result += board.isInCheck(WHITE) + board.isInCheck(BLACK);
+        }
+        return uint64_t(2 * BENCH_REPEATS);
+    });
+    PawnTable pawnTable;
+    _bench("evaluate", [&pawnTable](Board& board, uint64_t& result) {
+        for (int i = 0; i < BENCH_REPEATS; i++)
+        {
+            result += evaluate(board, pawnTable);
+        }
+        return uint64_t(BENCH_REPEATS);
+    });
+    if (getNetwork() != nullptr)
+    {
+        std::cout << "nnue kernel: " << nnueKernelName() << std::endl;
+        NnueEvaluator nnue(*getNetwork());
+        _bench("nnueRefresh", [&nnue](Board& board, uint64_t& result) {
+            nnue.reset(board);
+            result += nnue.evaluate(board);
+            return uint64_t(1);
+        });
+        _bench("nnueUpdate", [&nnue](Board& board, uint64_t& result) {
+            MoveList moves;
+            generateLegalMoves(board, moves);
+            nnue.reset(board);
+            for (int i = 0; i < BENCH_REPEATS; i++)
+            {
+                for (Move move: moves)
+                {
+                    nnue.push(board, move);
+                    nnue.pop();
+                }
+            }
+            result += moves.size();
+            return uint64_t(BENCH_REPEATS * moves.size());
+        });
+    }
+    _bench("canReach", [](Board& board, uint64_t& result) {
+        uint64_t calls = 0;
+        Bitboard occupied = board.getOccupancy();
+        while (occupied)
+        {
+            Piece* piece = board.getPiece(popLsb(occupied));
+            for (int dest = 0; dest < BOARD_SQUARES; dest++)
+            {
+                result += piece->canReach(Square(dest), (dest & 1) != 0);
+            }
+            calls += BOARD_SQUARES;
+        }
+        return calls;
+    });
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -3,15 +3,90 @@
 
 // ------------------------- includes --------------------------
 
+#include <cstring>
 #include "Game.h"
 
+// --------------------- const definitions ---------------------
+
+// flag choosing the color played by the engine
+constexpr auto ENGINE_FLAG = "--engine";
+// flag setting the search time of every engine move
+constexpr auto MOVETIME_FLAG = "--movetime";
+// flag setting the search depth of every engine move
+constexpr auto DEPTH_FLAG = "--depth";
+// flag setting the size of the engine's transposition table
+constexpr auto HASH_FLAG = "--hash";
+// flag setting the number of threads searching every engine move
+constexpr auto THREADS_FLAG = "--threads";
+// flag loading a network file that evaluates positions in place of the handcrafted evaluation
+constexpr auto NNUE_FLAG = "--nnue";
+// engine color input: white
+constexpr auto WHITE_INPUT = "white";
+// engine color input: black
+constexpr auto BLACK_INPUT = "black";
+// default search time of every engine move, in milliseconds
+constexpr uint64_t DEFAULT_MOVETIME = 1000;
+// error message of a network file that can't be loaded, followed by its path
+constexpr auto INVALID_NNUE_MESSAGE = "invalid network file: ";
+// usage message
+constexpr auto USAGE_MESSAGE =
+        "Usage: chess [--engine white|black] [--movetime <milliseconds>] [--depth <plies>]\n"
+        "             [--hash <megabytes>] [--threads <number>] [--nnue <file>]";
+
 // ----------------------  implementation ----------------------
 
 /**
- * The main function of the chess program. Runs a chess game.
+ * The main function of the chess program. Runs a chess game between two players, or between a
+ * player and the engine.
  */
-int main()
+int main(int argc, char* argv[])
 {
-    Game game;
+    int engineColor = 0;
+    size_t tableMegabytes = DEFAULT_TABLE_MEGABYTES;
+    int threadNum = 1;
+    SearchLimits limits;
+    limits.milliseconds = DEFAULT_MOVETIME;
+    for (int arg = 1; arg < argc; arg += 2)
+    {
+        if ((arg + 1 < argc) && (std::strcmp(argv[arg], ENGINE_FLAG) == 0) &&
+            ((std::strcmp(argv[arg + 1], WHITE_INPUT) == 0) ||
+             (std::strcmp(argv[arg + 1], BLACK_INPUT) == 0)))
+        {
+            engineColor = (std::strcmp(argv[arg + 1], WHITE_INPUT) == 0 ? WHITE: BLACK);
+        }
+        else if ((arg + 1 < argc) && (std::strcmp(argv[arg], MOVETIME_FLAG) == 0))
+        {
+            limits.milliseconds = std::strtoull(argv[arg + 1], nullptr, 10);
+        }
+        else if ((arg + 1 < argc) && (std::strcmp(argv[arg], DEPTH_FLAG) == 0) &&
+                 (std::atoi(argv[arg + 1]) > 0))
+        {
+            limits.depth = std::atoi(argv[arg + 1]);
+        }
+        else if ((arg + 1 < argc) && (std::strcmp(argv[arg], HASH_FLAG) == 0) &&
+                 (std::atoi(argv[arg + 1]) > 0))
+        {
+            tableMegabytes = std::atoi(argv[arg + 1]);
+        }
+        else if ((arg + 1 < argc) && (std::strcmp(argv[arg], THREADS_FLAG) == 0) &&
+                 (std::atoi(argv[arg + 1]) > 0))
+        {
+            threadNum = std::atoi(argv[arg + 1]);
+        }
+        else if ((arg + 1 < argc) && (std::strcmp(argv[arg], NNUE_FLAG) == 0))
+        {
+            if (!loadNetwork(argv[arg + 1]))
+            {
+                std::cerr << INVALID_NNUE_MESSAGE << argv[arg + 1] << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            std::cerr << USAGE_MESSAGE << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    Game game(engineColor, limits, tableMegabytes, threadNum);
     game.run();
 }
\ No newline at end of file
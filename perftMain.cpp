@@ -0,0 +1,177 @@
+// perftMain.cpp
+// This file contains the main function of the perft program, which counts the leaf nodes of the
+// legal move tree to measure the speed and check the correctness of the move generator.
+
+// ------------------------- includes --------------------------
+
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include "ParallelPerft.h"
+
+// --------------------- const definitions ---------------------
+
+// flag running the known positions suite
+constexpr auto SUITE_FLAG = "--suite";
+// flag setting the number of threads
+constexpr auto THREADS_FLAG = "--threads";
+// flag selecting the slider attack backend
+constexpr auto BACKEND_FLAG = "--backend";
+// default max depth of the known positions suite
+constexpr int DEFAULT_SUITE_DEPTH = 4;
+// usage message
+constexpr auto USAGE_MESSAGE =
+        "Usage: perft [--threads <number>] [--backend magic|pext] <depth> [fen]\n"
+        "       perft [--threads <number>] [--backend magic|pext] --suite [max depth]";
+// invalid FEN message
+constexpr auto INVALID_FEN_MESSAGE = "invalid FEN: ";
+// milliseconds in a second
+constexpr uint64_t MILLISECONDS = 1000;
+
+/**
+ * a position with a known number of leaf nodes at a given depth
+ */
+struct PerftEntry
+{
+    const char* fen; /** the position */
+    int depth; /** depth of the count */
+    uint64_t nodes; /** number of leaf nodes at depth */
+};
+
+// known positions, checked against published counts
+constexpr PerftEntry PERFT_SUITE[] = {
+        {START_FEN, 4, 197281},
+        {START_FEN, 5, 4865609},
+        {START_FEN, 6, 119060324},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3, 97862},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5, 674624},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6, 11030083},
+        {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4, 422333},
+        {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 5, 15833292},
+        {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3, 62379},
+        {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487},
+        {"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594}
+};
+
+// ----------------------  implementation ----------------------
+
+/**
+ * @brief counts the leaf nodes of the legal move tree to the given depth, and prints the count
+ * under every root move.
+ * @param board - the root position, left unchanged
+ * @param depth - depth of the tree, in plies. assumes: depth is at least 1.
+ * @param threadNum - number of threads counting the nodes
+ * @param out - stream to which the root moves and their counts are printed, one per line
+ * @return number of leaf nodes
+ */
+static uint64_t _divide(Board& board, int depth, int threadNum, std::ostream& out)
+{
+    if (threadNum == 1)
+    {
+        return perftDivide(board, depth, out);
+    }
+    return ParallelPerft(board, depth, threadNum).run(out);
+}
+
+/**
+ * @brief prints the node count, elapsed time and speed of a perft run
+ * @param nodes - number of counted leaf nodes
+ * @param start - time at which the run started
+ */
+static void _printSpeed(uint64_t nodes, std::chrono::steady_clock::time_point start)
+{
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    uint64_t nodesPerSecond = nodes * MILLISECONDS / (milliseconds > 0 ? milliseconds: 1);
+    std::cout << "nodes: " << nodes << ", time: " << milliseconds << " ms, nodes/sec: "
+              << nodesPerSecond << std::endl;
+}
+
+/**
+ * @brief runs perft on every known position up to the given depth, and compares the counts to the
+ * published ones.
+ * @param maxDepth - max depth of the checked counts
+ * @param threadNum - number of threads counting the nodes
+ * @return true if all counts match; false otherwise
+ */
+static bool _runSuite(int maxDepth, int threadNum)
+{
+    bool result = true;
+    uint64_t totalNodes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const PerftEntry& entry: PERFT_SUITE)
+    {
+        if (entry.depth > maxDepth)
+        {
+            continue;
+        }
+        Board board;
+        board.setPosition(entry.fen);
+        std::ostringstream divide;
+        uint64_t nodes = _divide(board, entry.depth, threadNum, divide);
+        totalNodes += nodes;
+        bool isCorrect = (nodes == entry.nodes);
+        result = result && isCorrect;
+        std::cout << (isCorrect ? "ok     ": "FAILED ") << entry.fen << " depth " << entry.depth
+                  << ": " << nodes << " (expected " << entry.nodes << ")" << std::endl;
+    }
+    _printSpeed(totalNodes, start);
+    return result;
+}
+
+/**
+ * The main function of the perft program. prints the node count under every root move of the
+ * given position (the initial position by default), or runs the known positions suite.
+ */
+int main(int argc, char* argv[])
+{
+    int arg = 1, threadNum = 1;
+    if ((argc > arg + 1) && (std::strcmp(argv[arg], THREADS_FLAG) == 0))
+    {
+        threadNum = std::atoi(argv[arg + 1]);
+        arg += 2;
+    }
+    if (threadNum < 1)
+    {
+        std::cerr << USAGE_MESSAGE << std::endl;
+        return EXIT_FAILURE;
+    }
+    if ((argc > arg + 1) && (std::strcmp(argv[arg], BACKEND_FLAG) == 0))
+    {
+        if (!setSliderBackend(argv[arg + 1]))
+        {
+            std::cerr << USAGE_MESSAGE << std::endl;
+            return EXIT_FAILURE;
+        }
+        arg += 2;
+    }
+    std::cout << "slider attack backend: " << sliderBackendName() << std::endl;
+    if ((argc > arg) && (std::strcmp(argv[arg], SUITE_FLAG) == 0))
+    {
+        int maxDepth = (argc > arg + 1 ? std::atoi(argv[arg + 1]): DEFAULT_SUITE_DEPTH);
+        return _runSuite(maxDepth, threadNum) ? EXIT_SUCCESS: EXIT_FAILURE;
+    }
+    int depth = (argc > arg ? std::atoi(argv[arg]): 0);
+    if (depth < 1)
+    {
+        std::cerr << USAGE_MESSAGE << std::endl;
+        return EXIT_FAILURE;
+    }
+    string fen = (argc > arg + 1 ? argv[arg + 1]: START_FEN);
+    for (int i = arg + 2; i < argc; i++)
+    {
+        fen = fen + " " + argv[i];
+    }
+    Board board;
+    if (!board.setPosition(fen))
+    {
+        std::cerr << INVALID_FEN_MESSAGE << fen << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t nodes = _divide(board, depth, threadNum, std::cout);
+    _printSpeed(nodes, start);
+    return EXIT_SUCCESS;
+}
\ No newline at end of file